@@ -0,0 +1,120 @@
+// bench/bench_common.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include <algorithm>
+
+// Shared helpers of the standalone benchmarks in bench/, each bench is one translation unit:
+//     g++ -std=c++20 -O2 -DNDEBUG -I.. simd_bench.cpp -o simd_bench
+// a bench defining LIBSSTRING_BENCH_COUNT_ALLOCATIONS before the include also replaces the global
+// operator new and delete so it can count heap traffic, every allocation of the process included
+
+// namespace libsstring_bench starts
+namespace libsstring_bench {
+
+    // results are folded in here so the optimizer cannot drop the measured work
+    inline volatile std::size_t sink = 0;
+
+    // @brief keep a value alive
+    template<typename T>
+    inline void keep(const T& v) noexcept {
+        sink = sink + static_cast<std::size_t>(v);
+    }
+    template<typename T>
+    inline void keep(const T* p) noexcept {
+        sink = sink + reinterpret_cast<std::uintptr_t>(p);
+    }
+
+    // @brief best of rounds runs of fn(), in nanoseconds per op for ops operations per run
+    template<typename Fn>
+    inline double ns_per_op(std::size_t ops, Fn&& fn, int rounds = 5) {
+        double best = 1e300;
+        for (int r = 0; r < rounds; ++r) {
+            const auto t0 = std::chrono::steady_clock::now();
+            fn();
+            const auto t1 = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+        }
+        return best / static_cast<double>(ops ? ops : 1);
+    }
+
+    // @brief print one result line, bytes per op turns the time into a throughput when non-zero
+    inline void report(const char* group, const char* name, std::size_t param, double ns, double bytes_per_op = 0) {
+        if (bytes_per_op > 0) {
+            std::printf("%-14s %-24s %10zu %12.2f ns %10.2f GB/s\n", group, name, param, ns, bytes_per_op / ns);
+        }
+        else {
+            std::printf("%-14s %-24s %10zu %12.2f ns\n", group, name, param, ns);
+        }
+    }
+
+}
+// namespace libsstring_bench ends
+
+#if defined(LIBSSTRING_BENCH_COUNT_ALLOCATIONS)
+
+#include <cstdlib>
+#include <new>
+
+// namespace libsstring_bench starts
+namespace libsstring_bench {
+
+    // heap traffic seen by the replaced operator new, single threaded benches only
+    inline std::size_t allocations = 0;
+    inline std::size_t allocated_bytes = 0;
+
+}
+// namespace libsstring_bench ends
+
+// gcc pairs the inlined replacement delete with the builtin new and flags the free
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t n) {
+    ++libsstring_bench::allocations;
+    libsstring_bench::allocated_bytes += n;
+    if (void* p = std::malloc(n ? n : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#endif
@@ -0,0 +1,98 @@
+// bench/growth_bench.cpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+// Append-heavy benchmarks of the heap growth policies around the SSO boundary: strings start
+// empty and grow one char or one 8-char piece at a time to a target length, so every run
+// crosses from SSO (29 chars) into the heap and through the first reallocations.
+// Each line reports the time and the heap allocations per finished string.
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#define LIBSSTRING_BENCH_COUNT_ALLOCATIONS
+#include "sstring.hpp"
+#include "bench_common.hpp"
+
+using namespace libsstring;
+using namespace libsstring_bench;
+
+namespace {
+
+    template<typename Growth>
+    using sstring_grow = basic_sstring<char, std::char_traits<char>, std::allocator<char>, std::uint8_t, 30, 16, share_none, Growth>;
+
+    constexpr std::size_t strings_per_run = 20000;
+
+    // @brief build strings_per_run strings of length len with appends of piece chars each
+    template<typename String>
+    void bench_append(const char* name, std::size_t len, std::size_t piece) {
+        const std::string src(piece, 'q');
+        const std::string_view pv(src);
+        std::size_t allocs = 0;
+        const double ns = ns_per_op(strings_per_run, [&] {
+            const std::size_t before = allocations;
+            for (std::size_t i = 0; i < strings_per_run; ++i) {
+                String s;
+                for (std::size_t k = 0; k < len; k += piece) {
+                    if (piece == 1) {
+                        s.push_back('q');
+                    }
+                    else {
+                        s.append(pv);
+                    }
+                }
+                keep(s.size());
+            }
+            allocs = allocations - before;
+        });
+        char label[64];
+        std::snprintf(label, sizeof label, "%s/%zu", name, piece);
+        std::printf("%-14s %-24s %10zu %12.2f ns %8.2f allocs\n", "append", label, len, ns,
+                    static_cast<double>(allocs) / strings_per_run);
+    }
+
+    void bench_length(std::size_t len, std::size_t piece) {
+        bench_append<sstring_grow<grow_double>>("grow_double", len, piece);
+        bench_append<sstring_grow<grow_half>>("grow_half", len, piece);
+        bench_append<sstring_grow<grow_size_class>>("grow_size_class", len, piece);
+        bench_append<std::string>("std::string", len, piece);
+    }
+
+}
+
+int main() {
+    const std::size_t lengths[] = { 24, 29, 30, 32, 40, 48, 64, 96, 128, 256, 1024, 4096 };
+    for (std::size_t piece : { std::size_t(1), std::size_t(8) }) {
+        for (std::size_t len : lengths) {
+            bench_length(len, piece);
+        }
+    }
+    return 0;
+}
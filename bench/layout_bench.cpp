@@ -0,0 +1,160 @@
+// bench/layout_bench.cpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+// Footprint and cache behaviour of the 24-byte sstring24 layout against the 32-byte sstring,
+// with std::string as a baseline. Millions of short strings are held in a std::vector and an
+// std::unordered_map; the report gives bytes per element from sizeof and from the heap, then
+// sequential scan, random access and hash lookup times, where the random access is the cache
+// miss proxy. Lengths 8 to 22 fit inline in every layout, 23 to 29 only in sstring.
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#define LIBSSTRING_BENCH_COUNT_ALLOCATIONS
+#include "sstring.hpp"
+#include "sstring_stdext.hpp"
+#include "bench_common.hpp"
+
+using namespace libsstring;
+using namespace libsstring_bench;
+
+namespace {
+
+    constexpr std::size_t vector_strings = std::size_t(4) << 20;
+    constexpr std::size_t map_strings = std::size_t(1) << 20;
+    constexpr std::size_t probes = std::size_t(1) << 22;
+    constexpr std::size_t map_probes = std::size_t(1) << 20;
+
+    // key buffer, keys are built in place so only the strings under test touch the heap
+    struct key_buffer {
+        char data[32];
+    };
+
+    // @brief deterministic key i, lowercase letters with a length in [min_len, max_len], max_len below 32
+    std::string_view make_key(key_buffer& buf, std::size_t i, std::size_t min_len, std::size_t max_len) {
+        std::uint64_t x = (i + 1) * 0x9E3779B97F4A7C15ull;
+        const std::size_t len = min_len + static_cast<std::size_t>(x % (max_len - min_len + 1));
+        char* s = buf.data;
+        for (std::size_t k = 0; k < len; ++k) {
+            x ^= x >> 29;
+            x *= 0xBF58476D1CE4E5B9ull;
+            s[k] = static_cast<char>('a' + (x >> 59) % 26);
+        }
+        s[0] = static_cast<char>('a' + i % 26);
+        return std::string_view(s, len);
+    }
+
+    // @brief random probe order shared by every layout
+    std::vector<std::uint32_t> make_order(std::size_t n, std::size_t count) {
+        std::mt19937_64 rng(42);
+        std::vector<std::uint32_t> order(count);
+        for (std::uint32_t& o : order) {
+            o = static_cast<std::uint32_t>(rng() % n);
+        }
+        return order;
+    }
+
+    template<typename String>
+    void bench_vector(const char* name, std::size_t min_len, std::size_t max_len, const std::vector<std::uint32_t>& order) {
+        std::vector<String> v;
+        v.reserve(vector_strings);
+        const std::size_t heap0 = allocated_bytes;
+        key_buffer buf;
+        for (std::size_t i = 0; i < vector_strings; ++i) {
+            v.emplace_back(make_key(buf, i, min_len, max_len));
+        }
+        const std::size_t heap1 = allocated_bytes;
+        std::printf("%-14s %-24s %10zu %8zu B sizeof %8.2f B/elem heap\n", "footprint", name, max_len, sizeof(String),
+                    static_cast<double>(heap1 - heap0) / vector_strings);
+
+        const double scan = ns_per_op(vector_strings, [&] {
+            std::size_t acc = 0;
+            for (const String& s : v) {
+                acc += s.size() + static_cast<unsigned char>(s[s.size() - 1]);
+            }
+            keep(acc);
+        });
+        report("scan", name, max_len, scan);
+
+        const double random = ns_per_op(order.size(), [&] {
+            std::size_t acc = 0;
+            for (std::uint32_t o : order) {
+                const String& s = v[o];
+                acc += s.size() + static_cast<unsigned char>(s[s.size() - 1]);
+            }
+            keep(acc);
+        });
+        report("random", name, max_len, random);
+    }
+
+    template<typename String>
+    void bench_map(const char* name, std::size_t min_len, std::size_t max_len, const std::vector<std::uint32_t>& order) {
+        std::unordered_map<String, std::uint32_t> m;
+        m.reserve(map_strings);
+        std::vector<String> queries;
+        queries.reserve(map_strings);
+        key_buffer buf;
+        for (std::size_t i = 0; i < map_strings; ++i) {
+            const std::string_view k = make_key(buf, i, min_len, max_len);
+            m.emplace(String(k), static_cast<std::uint32_t>(i));
+            queries.emplace_back(k);
+        }
+        const double ns = ns_per_op(map_probes, [&] {
+            std::size_t acc = 0;
+            for (std::size_t i = 0; i < map_probes; ++i) {
+                const std::uint32_t o = order[i];
+                const auto it = m.find(queries[o % map_strings]);
+                acc += it != m.end() ? it->second : 0;
+            }
+            keep(acc);
+        });
+        report("map find", name, max_len, ns);
+    }
+
+    void bench_lengths(std::size_t min_len, std::size_t max_len) {
+        const std::vector<std::uint32_t> order = make_order(vector_strings, probes);
+        bench_vector<sstring24>("sstring24", min_len, max_len, order);
+        bench_vector<sstring>("sstring", min_len, max_len, order);
+        bench_vector<std::string>("std::string", min_len, max_len, order);
+        bench_map<sstring24>("sstring24", min_len, max_len, order);
+        bench_map<sstring>("sstring", min_len, max_len, order);
+        bench_map<std::string>("std::string", min_len, max_len, order);
+    }
+
+}
+
+int main() {
+    bench_lengths(8, 22);
+    bench_lengths(23, 29);
+    return 0;
+}
@@ -0,0 +1,123 @@
+// bench/pool_bench.cpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+// Multithreaded allocation benchmarks of sstring_pooled against sstring on std::allocator at
+// 1, 8 and 32 threads. Every string is longer than the SSO buffer so each construction hits
+// the allocator. "churn" builds and drops strings on one thread, "handoff" frees each batch
+// on the next thread so the pool takes its remote free path. Times are wall clock per string
+// per thread, the pool counters are printed at the end.
+
+#include <barrier>
+#include <cstdio>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "sstring_pool.hpp"
+#include "bench_common.hpp"
+
+using namespace libsstring;
+using namespace libsstring_bench;
+
+namespace {
+
+    constexpr std::size_t ops_per_thread = 200000;
+    constexpr std::size_t live_strings = 64;
+    constexpr std::size_t batch_strings = 256;
+
+    // heap lengths spread over several pool size classes
+    constexpr std::size_t lengths[] = { 40, 72, 100, 180, 250, 500, 1000, 2000 };
+    const std::string source(2048, 'p');
+
+    // @brief run body(thread index) on threads threads and wait for all of them
+    template<typename Body>
+    void run_threads(std::size_t threads, Body&& body) {
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            pool.emplace_back(body, t);
+        }
+        for (std::thread& th : pool) {
+            th.join();
+        }
+    }
+
+    // @brief build and drop strings on one thread, a ring of live strings keeps the free lists busy
+    template<typename String>
+    void bench_churn(const char* name, std::size_t threads) {
+        const double ns = ns_per_op(ops_per_thread, [&] {
+            run_threads(threads, [](std::size_t t) {
+                std::vector<String> ring(live_strings);
+                for (std::size_t i = 0; i < ops_per_thread; ++i) {
+                    const std::size_t len = lengths[(i + t) % std::size(lengths)];
+                    ring[i % live_strings] = String(std::string_view(source.data(), len));
+                }
+                keep(ring[0].size());
+            });
+        }, 3);
+        report("churn", name, threads, ns);
+    }
+
+    // @brief thread t fills a batch, every thread then frees the batch of thread t + 1
+    template<typename String>
+    void bench_handoff(const char* name, std::size_t threads) {
+        const std::size_t rounds = ops_per_thread / batch_strings;
+        const double ns = ns_per_op(rounds * batch_strings, [&] {
+            std::vector<std::vector<String>> batches(threads);
+            std::barrier sync(static_cast<std::ptrdiff_t>(threads));
+            run_threads(threads, [&](std::size_t t) {
+                for (std::size_t r = 0; r < rounds; ++r) {
+                    std::vector<String>& mine = batches[t];
+                    mine.reserve(batch_strings);
+                    for (std::size_t i = 0; i < batch_strings; ++i) {
+                        mine.emplace_back(std::string_view(source.data(), lengths[(i + r) % std::size(lengths)]));
+                    }
+                    sync.arrive_and_wait();
+                    batches[(t + 1) % threads].clear();
+                    sync.arrive_and_wait();
+                }
+            });
+        }, 3);
+        report("handoff", name, threads, ns);
+    }
+
+}
+
+int main() {
+    for (std::size_t threads : { std::size_t(1), std::size_t(8), std::size_t(32) }) {
+        bench_churn<sstring>("sstring", threads);
+        bench_churn<sstring_pooled>("sstring_pooled", threads);
+        bench_handoff<sstring>("sstring", threads);
+        bench_handoff<sstring_pooled>("sstring_pooled", threads);
+    }
+    const pool_stats s = pool_statistics();
+    std::printf("pool: %zu allocations, %zu deallocations, %zu remote, %zu large, %zu slabs, %zu live threads\n",
+                s.allocations, s.deallocations, s.remote_deallocations, s.large_allocations, s.slabs, s.threads);
+    return 0;
+}
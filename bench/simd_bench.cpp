@@ -0,0 +1,137 @@
+// bench/simd_bench.cpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+// Microbenchmarks of the simd kernel layer, every kernel at every dispatch level this machine
+// supports, plus the libc routine it replaces as a baseline. Haystacks hold no match so each
+// call scans the whole buffer; sizes cover the short inline path and long scans.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "sstring_simd.hpp"
+#include "bench_common.hpp"
+
+using namespace libsstring;
+using namespace libsstring_bench;
+
+namespace {
+
+    const char* level_name(simd::simd_level l) {
+        switch (l) {
+        case simd::simd_level::scalar: return "scalar";
+        case simd::simd_level::sse2: return "sse2";
+        case simd::simd_level::avx2: return "avx2";
+        case simd::simd_level::avx512bw: return "avx512bw";
+        }
+        return "?";
+    }
+
+    // @brief calls per timed run, about 16 MiB of scanning
+    std::size_t reps_for(std::size_t n) {
+        return (std::size_t(16) << 20) / std::max<std::size_t>(n, 16);
+    }
+
+    void bench_size(const char* group, std::size_t n) {
+        std::vector<char> hay(n + 64, 'x');
+        std::vector<char> other(hay);
+        const char needle[] = "abcdefgz";
+        simd::byte_set set;
+        for (unsigned char c : std::string(" \t\n,;")) {
+            set.add(c);
+        }
+        const std::size_t reps = reps_for(n);
+        const char* h = hay.data();
+        const char* o = other.data();
+
+        report(group, "memchr", n, ns_per_op(reps, [&] {
+            for (std::size_t i = 0; i < reps; ++i) keep(simd::memchr(h, 'z', n));
+        }), static_cast<double>(n));
+        report(group, "find_pair", n, ns_per_op(reps, [&] {
+            for (std::size_t i = 0; i < reps; ++i) keep(simd::find_pair(h, 'y', 'z', n));
+        }), static_cast<double>(n));
+        report(group, "memcmp", n, ns_per_op(reps, [&] {
+            for (std::size_t i = 0; i < reps; ++i) keep(simd::memcmp(h, o, n));
+        }), static_cast<double>(n));
+        if (n >= 8) {
+            report(group, "find_substr/8", n, ns_per_op(reps, [&] {
+                for (std::size_t i = 0; i < reps; ++i) keep(simd::find_substr(h, n, needle, 8));
+            }), static_cast<double>(n));
+        }
+        report(group, "find_in_set", n, ns_per_op(reps, [&] {
+            for (std::size_t i = 0; i < reps; ++i) keep(simd::find_in_set(h, n, set, true));
+        }), static_cast<double>(n));
+        report(group, "rfind_in_set", n, ns_per_op(reps, [&] {
+            for (std::size_t i = 0; i < reps; ++i) keep(simd::rfind_in_set(h, n, set, true));
+        }), static_cast<double>(n));
+        report(group, "match_mask", n, ns_per_op(reps, [&] {
+            for (std::size_t i = 0; i < reps; ++i) keep(simd::match_mask(h, n, 'z'));
+        }), static_cast<double>(std::min<std::size_t>(n, 64)));
+        report(group, "set_match_mask", n, ns_per_op(reps, [&] {
+            for (std::size_t i = 0; i < reps; ++i) keep(simd::set_match_mask(h, n, set));
+        }), static_cast<double>(std::min<std::size_t>(n, 64)));
+    }
+
+    void bench_libc(std::size_t n) {
+        std::vector<char> hay(n + 64, 'x');
+        std::vector<char> other(hay);
+        const std::size_t reps = reps_for(n);
+        const char* h = hay.data();
+        const char* o = other.data();
+        report("libc", "memchr", n, ns_per_op(reps, [&] {
+            for (std::size_t i = 0; i < reps; ++i) keep(std::memchr(h, 'z', n));
+        }), static_cast<double>(n));
+        report("libc", "memcmp", n, ns_per_op(reps, [&] {
+            for (std::size_t i = 0; i < reps; ++i) keep(std::memcmp(h, o, n));
+        }), static_cast<double>(n));
+        if (n >= 8) {
+            const std::string_view sv(h, n);
+            report("libc", "string_view::find/8", n, ns_per_op(reps, [&] {
+                for (std::size_t i = 0; i < reps; ++i) keep(sv.find("abcdefgz", 0, 8));
+            }), static_cast<double>(n));
+        }
+    }
+
+}
+
+int main() {
+    const std::size_t sizes[] = { 7, 15, 31, 64, 256, 4096, 65536, 1 << 20 };
+    const simd::simd_level best = simd::set_level(simd::simd_level::avx512bw);
+    std::printf("best supported level: %s\n", level_name(best));
+    for (int l = 0; l <= static_cast<int>(best); ++l) {
+        const simd::simd_level lvl = simd::set_level(static_cast<simd::simd_level>(l));
+        for (std::size_t n : sizes) {
+            bench_size(level_name(lvl), n);
+        }
+    }
+    for (std::size_t n : sizes) {
+        bench_libc(n);
+    }
+    return 0;
+}
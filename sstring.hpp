@@ -38,12 +38,23 @@
 #include <algorithm>
 #include <iterator>
 #include <type_traits>
+#include <concepts>
 #include <array>
+#include <span>
 #include <memory>
 #include <memory_resource>
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <new>
 #include <cassert>
 #include <stdalign.h>
 
+#include "sstring_simd.hpp"
+#include "sstring_search.hpp"
+#include "sstring_hash.hpp"
+#include "sstring_charconv.hpp"
+
 // must support C++ 20
 #if defined(_MSVC_LANG)
 // MSVC Special Case
@@ -63,6 +74,44 @@
 #define _SSTRING_IS_VIRTUAL_DESTRUCTOR     0
 #endif
 
+// define sstring takes std::allocator blocks straight from malloc and keeps their usable size, they go back through free
+#ifndef _SSTRING_USE_MALLOC_USABLE_SIZE
+#define _SSTRING_USE_MALLOC_USABLE_SIZE    0
+#endif
+
+#if _SSTRING_USE_MALLOC_USABLE_SIZE != 0
+#include <cstdlib>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+#endif
+
+// define sstring maps huge std::allocator buffers with mmap and grows them with mremap (linux only)
+#ifndef _SSTRING_ENABLE_MREMAP
+#if defined(__linux__)
+#define _SSTRING_ENABLE_MREMAP             1
+#else
+#define _SSTRING_ENABLE_MREMAP             0
+#endif
+#endif
+
+// define sstring capacity in bytes from which buffers are mapped, a growth policy may override it with huge_threshold
+#ifndef _SSTRING_MREMAP_THRESHOLD
+#define _SSTRING_MREMAP_THRESHOLD          (std::size_t(16) << 20)
+#endif
+
+// define sstring asks for transparent huge pages on mapped buffers
+#ifndef _SSTRING_MREMAP_HUGEPAGE
+#define _SSTRING_MREMAP_HUGEPAGE           0
+#endif
+
+#if _SSTRING_ENABLE_MREMAP != 0
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 // namespace libsstring starts
 namespace libsstring {
 
@@ -93,6 +142,189 @@ namespace libsstring {
         allocator_holder_nonempty<Alloc>
     >;
 
+    // Heap sharing policy: every copy owns a private heap buffer
+    struct share_none {
+        static constexpr bool enabled = false;
+    };
+
+    // Heap sharing policy: copies share one refcounted heap buffer, cloned on the first write
+    struct share_cow {
+        static constexpr bool enabled = true;
+    };
+
+    // Heap sharing policy: heap buffers of at least Threshold bytes are shared refcounted and cloned on the first write,
+    // smaller heap buffers are copied eagerly and never touch a refcount
+    template<size_t Threshold = 4096>
+    struct share_large {
+        static constexpr bool enabled = true;
+        static constexpr size_t threshold = Threshold;
+    };
+
+    // @brief capacity from which a share policy shares its heap buffers, 0 shares every one
+    template<typename SharePolicy>
+    constexpr size_t share_threshold() noexcept {
+        if constexpr (requires { SharePolicy::threshold; }) {
+            return SharePolicy::threshold;
+        }
+        else {
+            return 0;
+        }
+    }
+
+    // Heap growth policy: double the capacity
+    struct grow_double {
+        // @brief capacity to allocate when current is too small for required, both include the null terminator
+        static constexpr size_t grow(size_t current, size_t required) noexcept {
+            return std::max(required, current * 2);
+        }
+    };
+
+    // Heap growth policy: grow by half, freed blocks can be reused by later growth
+    struct grow_half {
+        static constexpr size_t grow(size_t current, size_t required) noexcept {
+            return std::max(required, current + current / 2);
+        }
+    };
+
+    // @brief round up to a jemalloc style size class, 16 byte steps up to 128 then four classes per doubling
+    inline constexpr size_t malloc_size_class(size_t n) noexcept {
+        if (n <= 128) {
+            return n <= 16 ? 16 : (n + 15) & ~size_t(15);
+        }
+        const size_t step = std::bit_floor(n - 1) / 4;
+        return (n + step - 1) & ~(step - 1);
+    }
+
+    // Heap growth policy: grow by half then round up to the allocator size class the block lands in anyway
+    struct grow_size_class {
+        static constexpr size_t grow(size_t current, size_t required) noexcept {
+            return malloc_size_class(std::max(required, current + current / 2));
+        }
+    };
+
+    // @brief true when allocate_at_least serves Alloc from malloc so the usable size can be kept,
+    // std::allocator::deallocate needs the requested count back, so those blocks bypass it both ways
+    template<typename Alloc>
+    constexpr bool allocates_from_malloc() noexcept {
+        #if _SSTRING_USE_MALLOC_USABLE_SIZE != 0 && !defined(__cpp_lib_allocate_at_least)
+        using value_type = typename std::allocator_traits<Alloc>::value_type;
+        return std::is_same_v<Alloc, std::allocator<value_type>> && !requires(Alloc& a, size_t n) { a.allocate_at_least(n); };
+        #else
+        return false;
+        #endif
+    }
+
+    // @brief allocate at least n elements, n is updated to the usable count
+    // prefers an allocate_at_least member or allocator_traits::allocate_at_least, then malloc's usable size for std::allocator when enabled
+    template<typename Alloc>
+    constexpr typename std::allocator_traits<Alloc>::pointer allocate_at_least(Alloc& a, size_t& n) {
+        using traits = std::allocator_traits<Alloc>;
+        if constexpr (requires { a.allocate_at_least(n); }) {
+            auto r = a.allocate_at_least(n);
+            n = r.count;
+            return r.ptr;
+        }
+        else {
+            #if defined(__cpp_lib_allocate_at_least) && __cpp_lib_allocate_at_least >= 202302L
+            auto r = traits::allocate_at_least(a, n);
+            n = r.count;
+            return r.ptr;
+            #elif defined(__cpp_lib_allocate_at_least)
+            auto r = std::allocate_at_least(a, n);
+            n = r.count;
+            return r.ptr;
+            #else
+            #if _SSTRING_USE_MALLOC_USABLE_SIZE != 0
+            if constexpr (allocates_from_malloc<Alloc>()) {
+                using value_type = typename traits::value_type;
+                void* p = std::malloc(n * sizeof(value_type));
+                if (!p) [[unlikely]] {
+                    throw std::bad_alloc();
+                }
+                #if defined(__APPLE__)
+                n = malloc_size(p) / sizeof(value_type);
+                #elif defined(_MSC_VER)
+                n = _msize(p) / sizeof(value_type);
+                #else
+                n = malloc_usable_size(p) / sizeof(value_type);
+                #endif
+                return static_cast<typename traits::pointer>(p);
+            }
+            #endif
+            return traits::allocate(a, n);
+            #endif
+        }
+    }
+
+    // @brief give back a block of allocate_at_least, n is any count between the requested and the usable one
+    template<typename Alloc>
+    constexpr void deallocate_at_least(Alloc& a, typename std::allocator_traits<Alloc>::pointer p, size_t n) noexcept {
+        if constexpr (allocates_from_malloc<Alloc>()) {
+            std::free(p);
+        }
+        else {
+            std::allocator_traits<Alloc>::deallocate(a, p, n);
+        }
+    }
+
+    // @brief capacity from which a growth policy maps its buffers, 0 never maps
+    template<typename GrowthPolicy>
+    constexpr size_t growth_map_threshold() noexcept {
+        if constexpr (requires { GrowthPolicy::huge_threshold; }) {
+            return GrowthPolicy::huge_threshold;
+        }
+        else {
+            return _SSTRING_MREMAP_THRESHOLD;
+        }
+    }
+
+    #if _SSTRING_ENABLE_MREMAP != 0
+    // @brief system page size
+    inline size_t page_size() noexcept {
+        static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    // @brief round bytes up to whole pages
+    inline size_t page_round(size_t bytes) noexcept {
+        const size_t page = page_size();
+        return (bytes + page - 1) & ~(page - 1);
+    }
+
+    // @brief private anonymous mapping of at least bytes, bytes is updated to the mapped size
+    inline void* map_pages(size_t& bytes) {
+        bytes = page_round(bytes);
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        #if _SSTRING_MREMAP_HUGEPAGE != 0 && defined(MADV_HUGEPAGE)
+        ::madvise(p, bytes, MADV_HUGEPAGE);
+        #endif
+        return p;
+    }
+
+    // @brief resize a mapping, the kernel moves page tables instead of copying, new_bytes is updated to the mapped size
+    inline void* remap_pages(void* p, size_t old_bytes, size_t& new_bytes) {
+        new_bytes = page_round(new_bytes);
+        void* q = ::mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        if (q == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        #if _SSTRING_MREMAP_HUGEPAGE != 0 && defined(MADV_HUGEPAGE)
+        if (new_bytes > old_bytes) {
+            ::madvise(q, new_bytes, MADV_HUGEPAGE);
+        }
+        #endif
+        return q;
+    }
+
+    // @brief give a mapping back to the os right away
+    inline void unmap_pages(void* p, size_t bytes) noexcept {
+        ::munmap(p, bytes);
+    }
+    #endif
+
     // Implementation of sstring
     template<
         typename CharT = char,
@@ -100,7 +332,9 @@ namespace libsstring {
         typename Allocator = std::allocator<CharT>,
         typename SSO_FlagType = std::uint8_t,
         size_t   SSO_ReservedBytes = 30,
-        size_t   SSO_StructAlignByte = 16
+        size_t   SSO_StructAlignByte = 16,
+        typename SharePolicy = share_none,
+        typename GrowthPolicy = grow_double
     >
     class basic_sstring : private allocator_holder<Allocator> {
         static_assert(sizeof(CharT) == 1, "basic_sstring currently supports only byte-sized CharT, aka. char");
@@ -116,6 +350,8 @@ namespace libsstring {
         using traits_type_public = Traits;
         using allocator_type_public = Allocator;
         using flag_type = SSO_FlagType;
+        using share_policy = SharePolicy;
+        using growth_policy = GrowthPolicy;
         using byte_type = unsigned char;
         using size_type = std::size_t;
         using bool_type = bool;
@@ -137,13 +373,24 @@ namespace libsstring {
         constexpr static inline bool_type HeapPaddingState = SSO_ReservedBytes + 2 * sizeof(flag_type) > HeapBasicSize;
         constexpr static inline size_type HeapPaddingSize = HeapPaddingState ? SSO_ReservedBytes + 2 * sizeof(flag_type) - HeapBasicSize : SSO_StructAlignByte;
 
+        // compact layout, the sso buffer and one tag byte fill exactly ptr, size and cap
+        // the heap flag word folds into cap and the sso length is kept as remaining room in the tag byte
+        constexpr static inline bool_type CompactLayout = SSO_ReservedBytes + sizeof(flag_type) == sizeof(CharT*) + 2 * sizeof(size_type);
+
         // small string optimization
-        struct alignas(SSO_StructAlignByte) SSO {
+        struct alignas(SSO_StructAlignByte) SSOWide {
             byte_type buf[SSO_ReservedBytes];
             flag_type len;                           // length (0 -> N - 1)
             flag_type tag;                           // tag byte (used to overlap heap.flag MSB)
         };
 
+        // small string optimization, compact, the last byte holds N - 1 - length so a full string's terminator is also its length
+        struct alignas(SSO_StructAlignByte) SSOCompact {
+            byte_type buf[SSO_ReservedBytes + 1];    // buf[N - 1] is the tag byte (used to overlap heap.cap MSB)
+        };
+
+        using SSO = std::conditional_t<CompactLayout, SSOCompact, SSOWide>;
+
         // heap allocated strings, Base
         template <bool_type _HasPadding>
         struct alignas(SSO_StructAlignByte) Heap;
@@ -167,17 +414,32 @@ namespace libsstring {
             size_type flag;                          // highest bit used as is - heap flag
         };
 
+        // heap allocated strings, compact, the top byte of cap holds the heap flag word
+        struct alignas(SSO_StructAlignByte) HeapCompact {
+            CharT* ptr;                              // data ptr
+            size_type size;                          // size, used
+            size_type cap;                           // capacity below the top byte, highest bit used as is - heap flag
+        };
+
         // storage union without padding
         union alignas(SSO_StructAlignByte) Storage {
             // small string optimization
             SSO sso;
 
             // heap allocated strings, compatible for std::string
-            Heap<HeapPaddingState> heap;
+            std::conditional_t<CompactLayout, HeapCompact, Heap<HeapPaddingState>> heap;
+
+            // default constructor, an empty sso string
+            constexpr Storage() noexcept {
+                std::memset(this, 0, sizeof(Storage));
+                if constexpr (CompactLayout) {
+                    sso.buf[SSO_ReservedBytes] = static_cast<byte_type>(SSO_ReservedBytes);
+                }
+            }
+        };
 
-            // default constructor
-            constexpr Storage() noexcept { std::memset(this, 0, sizeof(Storage)); }
-        } storage;
+        // mutable only so that const hash() can memoize into the heap header
+        mutable Storage storage;
 
         // total length of a storage
         static constexpr size_type TOTAL_BYTES = sizeof(Storage);
@@ -186,6 +448,58 @@ namespace libsstring {
         static constexpr size_type SIZE_T_BITS = sizeof(size_type) * 8;
         static constexpr size_type HEAP_FLAG = size_type(1) << (SIZE_T_BITS - 1);
 
+        // heap mode bit, ptr views static storage that is never freed nor written, the first write copies it
+        static constexpr size_type HEAP_STATIC = size_type(1) << (SIZE_T_BITS - 2);
+
+        // heap tier bit, the block is large and carries a refcount under tiered sharing, below the offset code when compact
+        static constexpr size_type HEAP_LARGE = size_type(1) << (CompactLayout ? SIZE_T_BITS - 7 : SIZE_T_BITS - 3);
+
+        // heap start offset, 4 bits below the tag byte; offsets past 7 spill into the head bytes before ptr
+        static constexpr size_type HEAP_OFFSET_SHIFT = CompactLayout ? SIZE_T_BITS - 6 : SIZE_T_BITS - 12;
+        static constexpr size_type HEAP_OFFSET_MASK = size_type(0xF) << HEAP_OFFSET_SHIFT;
+        static constexpr size_type HEAP_OFFSET_INLINE_MAX = 7;
+        static constexpr size_type HEAP_OFFSET_SPILLED = 8;
+        static_assert(sizeof(size_type) <= HEAP_OFFSET_SPILLED, "a spilled heap offset must fit in the skipped head bytes");
+
+        // shared heap buffers keep an atomic refcount in the size_type word right before the allocation start
+        static constexpr bool_type HeapShared = SharePolicy::enabled;
+        using refcount_type = std::atomic<size_type>;
+        using word_alloc_type = typename alloc_traits::template rebind_alloc<size_type>;
+        using word_alloc_traits = std::allocator_traits<word_alloc_type>;
+        static_assert(!HeapShared || (sizeof(refcount_type) == sizeof(size_type) && alignof(refcount_type) <= alignof(size_type)),
+            "basic_sstring copy-on-write needs a lock-free size_type sized atomic refcount");
+
+        // huge std::allocator buffers live in their own mapping, a block is mapped exactly when its whole capacity reaches the threshold
+        static constexpr size_type HEAP_MAP_THRESHOLD = growth_map_threshold<GrowthPolicy>();
+        static constexpr bool_type HeapMapped = _SSTRING_ENABLE_MREMAP != 0 && HEAP_MAP_THRESHOLD != 0 && std::is_same_v<Allocator, std::allocator<CharT>>;
+        static constexpr size_type HEAP_BLOCK_HEADER = HeapShared ? sizeof(size_type) : 0;
+
+        // tiered sharing, only blocks whose whole capacity reaches the threshold carry a refcount, mapped blocks always do
+        static constexpr size_type HEAP_SHARE_THRESHOLD = HeapMapped && share_threshold<SharePolicy>() > HEAP_MAP_THRESHOLD
+            ? HEAP_MAP_THRESHOLD : share_threshold<SharePolicy>();
+        static constexpr bool_type HeapTiered = HeapShared && HEAP_SHARE_THRESHOLD != 0;
+
+        // allocators exposing try_extend(p, old_n, new_n) can grow the most recent block in place, e.g. bump arenas
+        static constexpr bool_type HeapExtensible = !HeapShared && requires(Allocator& a, CharT* p, size_type n) {
+            { a.try_extend(p, n, n) } -> std::convertible_to<bool>;
+        };
+
+        // compact cap keeps the flag bits in its top byte
+        static constexpr size_type HEAP_CAP_MASK = CompactLayout ? (size_type(1) << (SIZE_T_BITS - 8)) - 1 : ~size_type(0);
+
+        // memoized hash of heap strings, kept in the free low flag bits below a valid bit,
+        // only 64-bit wide layouts have room for a whole hash there
+        static constexpr bool_type HeapHashMemo = !CompactLayout && SIZE_T_BITS >= 64;
+        static constexpr size_type HEAP_HASH_BITS = HEAP_OFFSET_SHIFT - 1;
+        static constexpr size_type HEAP_HASH_VALID = HeapHashMemo ? size_type(1) << HEAP_HASH_BITS : 0;
+        static constexpr size_type HEAP_HASH_MASK = HeapHashMemo ? HEAP_HASH_VALID - 1 : 0;
+        static_assert(!HeapHashMemo || HEAP_HASH_BITS == hash_bits, "the memoized hash must hold a whole libsstring hash");
+
+        // heap mode bit, a writable pointer into the buffer escaped: copies take a private buffer and the hash is not memoized,
+        // a fresh buffer clears it; the spare bit under the compact cap byte, below the tier bit otherwise
+        static constexpr bool_type HeapTracksLeaks = HeapShared || HeapHashMemo;
+        static constexpr size_type HEAP_LEAKED = HeapTracksLeaks ? size_type(1) << (CompactLayout ? SIZE_T_BITS - 8 : SIZE_T_BITS - 4) : 0;
+
         // requires little-endian for tag-cap overlap strategy
         static constexpr bool platform_is_little_endian() {
             #if defined(__cpp_lib_endian)
@@ -202,10 +516,24 @@ namespace libsstring {
         // @brief reset storage to nothing - sso with 0 length
         static constexpr void reset_storage(Storage& dest) {
             std::memset(&dest, 0, sizeof(Storage));
+            if constexpr (CompactLayout) {
+                dest.sso.buf[SSO_ReservedBytes] = static_cast<byte_type>(SSO_ReservedBytes);
+            }
         }
 
-        // @brief copy storage
+        // @brief copy storage, a flag word that const hash() may be memoizing into is loaded atomically
         static constexpr void copy_storage(Storage& dest, const Storage& src) {
+            if constexpr (HeapHashMemo) {
+                if (!std::is_constant_evaluated()) {
+                    const size_type at = static_cast<size_type>(reinterpret_cast<const byte_type*>(&src.heap.flag) - reinterpret_cast<const byte_type*>(&src));
+                    const size_type flag = heap_flag_of(src);
+                    std::memcpy(&dest, &src, at);
+                    std::memcpy(&dest.heap.flag, &flag, sizeof(size_type));
+                    std::memcpy(reinterpret_cast<byte_type*>(&dest) + at + sizeof(size_type),
+                                reinterpret_cast<const byte_type*>(&src) + at + sizeof(size_type), sizeof(Storage) - at - sizeof(size_type));
+                    return;
+                }
+            }
             std::memcpy(&dest, &src, sizeof(Storage));
         }
 
@@ -215,9 +543,40 @@ namespace libsstring {
             reset_storage(src);
         }
 
+        // @brief heap flag word of a storage, the compact layout shares it with cap
+        static constexpr size_type& heap_flag_of(Storage& st) noexcept {
+            if constexpr (CompactLayout) {
+                return st.heap.cap;
+            }
+            else {
+                return st.heap.flag;
+            }
+        }
+        // const readers load it relaxed, a concurrent const hash() may be storing its memo there
+        static constexpr size_type heap_flag_of(const Storage& st) noexcept {
+            if constexpr (CompactLayout) {
+                return st.heap.cap;
+            }
+            else if constexpr (HeapHashMemo) {
+                if (std::is_constant_evaluated()) {
+                    return st.heap.flag;
+                }
+                return std::atomic_ref<size_type>(const_cast<size_type&>(st.heap.flag)).load(std::memory_order_relaxed);
+            }
+            else {
+                return st.heap.flag;
+            }
+        }
+        constexpr size_type& heap_flag_word() noexcept {
+            return heap_flag_of(storage);
+        }
+        constexpr size_type heap_flag_word() const noexcept {
+            return heap_flag_of(std::as_const(storage));
+        }
+
         // @brief get is heap allocated
         constexpr bool is_heap() const noexcept {
-            return (storage.heap.flag & HEAP_FLAG) != 0;
+            return (heap_flag_word() & HEAP_FLAG) != 0;
         }
         
         // @brief get is sso mode
@@ -225,19 +584,216 @@ namespace libsstring {
             return !is_heap();
         }
 
-        // @brief set flag as heap-allocated
+        // @brief get is a non-owning view of static storage
+        constexpr bool is_static_heap() const noexcept {
+            return (heap_flag_word() & HEAP_STATIC) != 0;
+        }
+
+        // @brief set flag as heap-allocated, a fresh buffer carries no heap metadata
+        // a fresh block starts at its allocation, so cap is its whole capacity and decides the tier
         constexpr void set_heap_flag() noexcept {
-            storage.heap.flag |= HEAP_FLAG;
+            size_type tier = 0;
+            if constexpr (HeapTiered) {
+                tier = heap_capacity_raw() >= HEAP_SHARE_THRESHOLD ? HEAP_LARGE : 0;
+            }
+            if constexpr (CompactLayout) {
+                storage.heap.cap = (storage.heap.cap & HEAP_CAP_MASK) | HEAP_FLAG | tier;
+            }
+            else {
+                storage.heap.flag = HEAP_FLAG | tier;
+            }
+        }
+
+        // @brief true when the heap block described by st carries a refcount
+        static constexpr bool_type heap_counted_of(const Storage& st) noexcept {
+            if constexpr (HeapTiered) {
+                return (heap_flag_of(st) & HEAP_LARGE) != 0;
+            }
+            else {
+                return HeapShared;
+            }
+        }
+        // @brief true when a block of capacity chars, counted from its allocation start, carries a refcount
+        static constexpr bool_type block_counted(size_type capacity) noexcept {
+            if constexpr (HeapTiered) {
+                return capacity >= HEAP_SHARE_THRESHOLD;
+            }
+            else {
+                return HeapShared;
+            }
         }
         
         // @brief set as non-heap allocated, aka. sso
         constexpr void clear_heap_flag() noexcept {
-            storage.sso.tag = 0;
+            if constexpr (CompactLayout) {
+                storage.sso.buf[SSO_ReservedBytes] &= static_cast<byte_type>(0x7F);
+            }
+            else {
+                storage.sso.tag = 0;
+            }
         }
         
-        // @brief get raw heap capacity as a size_type
+        // @brief get raw heap capacity as a size_type, counted from the current start
+        static constexpr size_type heap_cap_of(const Storage& st) noexcept {
+            return st.heap.cap & HEAP_CAP_MASK;
+        }
         constexpr size_type heap_capacity_raw() const noexcept {
-            return storage.heap.cap;
+            return heap_cap_of(storage);
+        }
+
+        // @brief set raw heap capacity, the flag bits sharing a compact cap are kept
+        constexpr void set_heap_cap(size_type cap) noexcept {
+            if constexpr (CompactLayout) {
+                storage.heap.cap = (storage.heap.cap & ~HEAP_CAP_MASK) | cap;
+            }
+            else {
+                storage.heap.cap = cap;
+            }
+        }
+
+        // @brief get the number of head bytes skipped by prefix removal
+        static constexpr size_type heap_offset_of(const Storage& st) noexcept {
+            size_type code = (heap_flag_of(st) & HEAP_OFFSET_MASK) >> HEAP_OFFSET_SHIFT;
+            if (code <= HEAP_OFFSET_INLINE_MAX) [[likely]] {
+                return code;
+            }
+            size_type off;
+            std::memcpy(&off, st.heap.ptr - sizeof(size_type), sizeof(size_type));
+            return off;
+        }
+        constexpr size_type heap_offset() const noexcept {
+            return heap_offset_of(storage);
+        }
+
+        // @brief record the head offset, ptr must already point at the new start
+        constexpr void set_heap_offset(size_type off) noexcept {
+            size_type code = off;
+            if (off > HEAP_OFFSET_INLINE_MAX) {
+                // the skipped bytes are dead, keep the offset right before the data
+                std::memcpy(storage.heap.ptr - sizeof(size_type), &off, sizeof(size_type));
+                code = HEAP_OFFSET_SPILLED;
+            }
+            heap_flag_word() = (heap_flag_word() & ~HEAP_OFFSET_MASK) | (code << HEAP_OFFSET_SHIFT);
+        }
+
+        // @brief drop the hold on the heap buffer described by st, the last holder frees it from its allocation start
+        constexpr void release_heap_storage(const Storage& st) noexcept {
+            if (heap_flag_of(st) & HEAP_STATIC) {
+                return;
+            }
+            size_type off = heap_offset_of(st);
+            CharT* base = st.heap.ptr - off;
+            if constexpr (HeapShared) {
+                if (heap_counted_of(st) && shared_refcount(base)->fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                    return;
+                }
+            }
+            deallocate_buffer(base, heap_cap_of(st) + off);
+        }
+        constexpr void release_heap() noexcept {
+            release_heap_storage(storage);
+        }
+
+        // @brief refcount of a shared heap buffer from its allocation start
+        static refcount_type* shared_refcount(CharT* base) noexcept {
+            return std::launder(reinterpret_cast<refcount_type*>(reinterpret_cast<size_type*>(base) - 1));
+        }
+
+        // @brief words of a shared block holding capacity chars behind the refcount
+        static constexpr size_type shared_words(size_type capacity) noexcept {
+            return 1 + (capacity + sizeof(size_type) - 1) / sizeof(size_type);
+        }
+
+        // @brief true when no other string holds the heap buffer, static storage is never owned
+        constexpr bool_type heap_unique() const noexcept {
+            if (is_static_heap()) {
+                return false;
+            }
+            if constexpr (HeapShared) {
+                return !heap_counted_of(storage) || shared_refcount(storage.heap.ptr - heap_offset())->load(std::memory_order_acquire) == 1;
+            }
+            else {
+                return true;
+            }
+        }
+
+        // @brief take a reference on other's heap buffer, false when the allocators cannot share it or it is not refcounted
+        // static storage is shared by every policy, copying it only copies the view
+        constexpr bool_type share_heap_from(const basic_sstring& other) noexcept {
+            if (other.is_static_heap()) {
+                copy_storage(storage, other.storage);
+                return true;
+            }
+            if constexpr (HeapShared) {
+                if (!heap_counted_of(other.storage) || (other.heap_flag_word() & HEAP_LEAKED)) {
+                    return false;
+                }
+                if constexpr (!alloc_traits::is_always_equal::value) {
+                    if (!(get_alloc() == other.get_alloc())) {
+                        return false;
+                    }
+                }
+                shared_refcount(other.storage.heap.ptr - other.heap_offset())->fetch_add(1, std::memory_order_relaxed);
+                copy_storage(storage, other.storage);
+                return true;
+            }
+            else {
+                return false;
+            }
+        }
+
+        // @brief drop the memoized hash before the content changes
+        constexpr void forget_hash() noexcept {
+            if (is_heap()) {
+                heap_flag_word() &= ~(HEAP_HASH_VALID | HEAP_HASH_MASK);
+            }
+        }
+
+        // @brief a writable pointer into the heap buffer escapes to the caller, see HEAP_LEAKED
+        constexpr void leak_heap() noexcept {
+            if constexpr (HeapTracksLeaks) {
+                if (is_heap()) {
+                    heap_flag_word() |= HEAP_LEAKED;
+                }
+            }
+        }
+
+        // @brief every in-place write starts here, unshare the buffer and drop the memoized hash
+        // need is the capacity the write is about to require, including the null terminator, so a detach lands in it directly
+        constexpr void prepare_write(size_type need = 0) {
+            detach(need);
+            forget_hash();
+        }
+
+        // @brief give this string a private copy of a shared or static heap buffer before writing to it
+        constexpr void detach(size_type need = 0) {
+            if (is_heap() && !heap_unique()) [[unlikely]] {
+                size_type sz = storage.heap.size;
+                size_type cap = heap_capacity_raw();
+                if (need > cap) {
+                    cap = GrowthPolicy::grow(cap, need);
+                }
+                CharT* p = allocate_buffer(cap);
+                std::memcpy(p, storage.heap.ptr, sz);
+                p[sz] = '\0';
+                release_heap();
+                storage.heap.ptr = p;
+                set_heap_cap(cap);
+                set_heap_flag();
+            }
+        }
+
+        // @brief move the data back to the allocation start, O(size)
+        constexpr void compact_heap() noexcept {
+            size_type off = heap_offset();
+            if (off == 0) {
+                return;
+            }
+            CharT* base = storage.heap.ptr - off;
+            traits_move(base, storage.heap.ptr, storage.heap.size + 1);
+            storage.heap.ptr = base;
+            set_heap_cap(heap_capacity_raw() + off);
+            set_heap_offset(0);
         }
        
         // @brief get raw sso capacity as a size_type
@@ -254,17 +810,47 @@ namespace libsstring {
 
         // @brief get current size when using sso
         constexpr flag_type sso_size() const noexcept {
-            return storage.sso.len;
+            if constexpr (CompactLayout) {
+                return static_cast<flag_type>(SSO_ReservedBytes - storage.sso.buf[SSO_ReservedBytes]);
+            }
+            else {
+                return storage.sso.len;
+            }
+        }
+
+        // @brief set current size when using sso, the compact tag byte also leaves heap mode
+        constexpr void set_sso_size(size_type n) noexcept {
+            if constexpr (CompactLayout) {
+                storage.sso.buf[SSO_ReservedBytes] = static_cast<byte_type>(SSO_ReservedBytes - n);
+            }
+            else {
+                storage.sso.len = static_cast<flag_type>(n);
+            }
         }
 
         // @brief comparasion simd memchr
         static constexpr const void* simd_memchr(const void* buf, int c, size_t n) noexcept {
-            return std::memchr(buf, c, n);
+            return simd::memchr(buf, c, n);
+        }
+
+        // @brief comparasion simd adjacent pair search
+        static constexpr const void* simd_find_pair(const void* buf, int a, int b, size_t n) noexcept {
+            return simd::find_pair(buf, a, b, n);
         }
 
         // @brief comparasion simd memcmp
         static constexpr int simd_memcmp(const void* a, const void* b, size_t n) noexcept {
-            return std::memcmp(a, b, n);
+            return simd::memcmp(a, b, n);
+        }
+
+        // @brief traits aware compare, plain char traits go through the simd kernel
+        static constexpr int traits_compare(const CharT* a, const CharT* b, size_type n) noexcept {
+            if constexpr (std::is_same_v<Traits, std::char_traits<CharT>>) {
+                return simd_memcmp(a, b, n);
+            }
+            else {
+                return Traits::compare(a, b, n);
+            }
         }
 
         // @brief get allocator access
@@ -277,19 +863,79 @@ namespace libsstring {
 
         // @brief ensure null-termination depending on mode
         constexpr void ensure_sso_null_terminated() noexcept {
-            storage.sso.buf[storage.sso.len] = '\0'; 
+            storage.sso.buf[sso_size()] = '\0'; 
         }
         constexpr void ensure_heap_null_terminated() noexcept {
             storage.heap.ptr[storage.heap.size] = '\0'; 
         }
 
-        // @brief allocate buffer via allocator_traits
-        constexpr CharT* allocate_buffer(size_type capacity) {
+        // @brief allocate buffer via allocator_traits, capacity is raised to what the allocator really handed out
+        constexpr CharT* allocate_buffer(size_type& capacity) {
             // allocate capacity elements (capacity includes space for null terminator)
-            return alloc_traits::allocate(get_alloc(), capacity);
+            #if _SSTRING_ENABLE_MREMAP != 0
+            if constexpr (HeapMapped) {
+                if (capacity >= HEAP_MAP_THRESHOLD) [[unlikely]] {
+                    size_type bytes = capacity + HEAP_BLOCK_HEADER;
+                    byte_type* block = static_cast<byte_type*>(map_pages(bytes));
+                    if constexpr (HeapShared) {
+                        ::new (static_cast<void*>(block)) refcount_type(1);
+                    }
+                    capacity = bytes - HEAP_BLOCK_HEADER;
+                    return reinterpret_cast<CharT*>(block + HEAP_BLOCK_HEADER);
+                }
+            }
+            #endif
+            CharT* p = allocate_heap_block(capacity);
+            if constexpr (HeapMapped) {
+                // allocator slack must not make the block look mapped
+                capacity = std::min(capacity, HEAP_MAP_THRESHOLD - 1);
+            }
+            return p;
+        }
+        constexpr CharT* allocate_heap_block(size_type& capacity) {
+            if constexpr (HeapTiered) {
+                // a medium block stays below the threshold whatever slack the allocator hands back
+                if (!block_counted(capacity)) {
+                    CharT* p = libsstring::allocate_at_least(get_alloc(), capacity);
+                    capacity = std::min(capacity, HEAP_SHARE_THRESHOLD - 1);
+                    return p;
+                }
+            }
+            if constexpr (HeapShared) {
+                // word-aligned block, refcount first and the chars right after it
+                word_alloc_type wa(get_alloc());
+                size_type words = shared_words(capacity);
+                size_type* block = libsstring::allocate_at_least(wa, words);
+                ::new (static_cast<void*>(block)) refcount_type(1);
+                capacity = (words - 1) * sizeof(size_type);
+                return reinterpret_cast<CharT*>(block + 1);
+            }
+            else {
+                return libsstring::allocate_at_least(get_alloc(), capacity);
+            }
         }
         constexpr void deallocate_buffer(CharT* p, size_type cap) noexcept {
-            alloc_traits::deallocate(get_alloc(), p, cap);
+            #if _SSTRING_ENABLE_MREMAP != 0
+            if constexpr (HeapMapped) {
+                if (cap >= HEAP_MAP_THRESHOLD) [[unlikely]] {
+                    if constexpr (HeapShared) {
+                        shared_refcount(p)->~refcount_type();
+                    }
+                    unmap_pages(reinterpret_cast<byte_type*>(p) - HEAP_BLOCK_HEADER, cap + HEAP_BLOCK_HEADER);
+                    return;
+                }
+            }
+            #endif
+            if constexpr (HeapShared) {
+                if (block_counted(cap)) {
+                    refcount_type* rc = shared_refcount(p);
+                    rc->~refcount_type();
+                    word_alloc_type wa(get_alloc());
+                    libsstring::deallocate_at_least(wa, reinterpret_cast<size_type*>(rc), shared_words(cap));
+                    return;
+                }
+            }
+            libsstring::deallocate_at_least(get_alloc(), p, cap);
         }
 
         // @brief copy using traits
@@ -306,32 +952,98 @@ namespace libsstring {
         // @brief reallocate heap capacity and copy memory
         constexpr void reallocate_heap_copy(size_type new_capacity) {
             size_type cur_cap = heap_capacity_raw();
-            size_type newcap = std::max(new_capacity, cur_cap * 2);
+            // head waste at least as large as the data: sliding back is as cheap as a copy and needs no allocation
+            size_type off = heap_offset();
+            if (off >= storage.heap.size && cur_cap + off >= new_capacity && heap_unique()) {
+                compact_heap();
+                return;
+            }
+            if constexpr (HeapExtensible) {
+                size_type want = GrowthPolicy::grow(cur_cap, new_capacity) + off;
+                if (heap_unique() && get_alloc().try_extend(storage.heap.ptr - off, cur_cap + off, want)) {
+                    set_heap_cap(want - off);
+                    return;
+                }
+            }
+            #if _SSTRING_ENABLE_MREMAP != 0
+            // a mapped block grows in place or moves its pages, the data is never copied
+            if constexpr (HeapMapped) {
+                if (cur_cap + off >= HEAP_MAP_THRESHOLD && heap_unique()) {
+                    size_type old_bytes = cur_cap + off + HEAP_BLOCK_HEADER;
+                    size_type bytes = GrowthPolicy::grow(cur_cap + off, new_capacity + off) + HEAP_BLOCK_HEADER;
+                    byte_type* block = static_cast<byte_type*>(remap_pages(storage.heap.ptr - off - HEAP_BLOCK_HEADER, old_bytes, bytes));
+                    storage.heap.ptr = reinterpret_cast<CharT*>(block + HEAP_BLOCK_HEADER + off);
+                    set_heap_cap(bytes - HEAP_BLOCK_HEADER - off);
+                    return;
+                }
+            }
+            #endif
+            size_type newcap = GrowthPolicy::grow(cur_cap, new_capacity);
             CharT* p = allocate_buffer(newcap);
             // copy existing
             std::memcpy(p, storage.heap.ptr, storage.heap.size);
             p[storage.heap.size] = '\0';
             // dealloc old
-            deallocate_buffer(storage.heap.ptr, cur_cap);
+            release_heap();
             storage.heap.ptr = p;
-            storage.heap.cap = newcap;
+            set_heap_cap(newcap);
             set_heap_flag();
             return;
         }
 
+        // @brief drop n leading chars in place, heap strings only advance their start
+        constexpr void drop_front(size_type n) {
+            if (n == 0) {
+                return;
+            }
+            prepare_write();
+            if (is_sso()) [[likely]] {
+                size_type rest = sso_size() - n;
+                std::memmove(storage.sso.buf, storage.sso.buf + n, rest);
+                set_sso_size(rest);
+                storage.sso.buf[rest] = '\0';
+            }
+            else {
+                // compaction is left to the next growth, which slides back once the head outweighs the data
+                size_type off = heap_offset() + n;
+                storage.heap.ptr += n;
+                set_heap_cap(heap_capacity_raw() - n);
+                storage.heap.size -= n;
+                set_heap_offset(off);
+            }
+        }
+
+        // @brief drop n trailing chars in place
+        constexpr void drop_back(size_type n) {
+            if (n == 0) {
+                return;
+            }
+            prepare_write();
+            if (is_sso()) [[likely]] {
+                size_type rest = sso_size() - n;
+                set_sso_size(rest);
+                storage.sso.buf[rest] = '\0';
+            }
+            else {
+                storage.heap.size -= n;
+                storage.heap.ptr[storage.heap.size] = '\0';
+            }
+        }
+
         // @brief ensure heap mode and reserve at least new_capacity bytes (includes space for null termin.)
         constexpr void make_non_sso_and_reserve(size_type new_capacity) {
             // if sso, then need to copy data
             if (is_sso()) {
-                size_type cur_len = storage.sso.len;
-                size_type cap = std::max(new_capacity, cur_len + 1);
+                size_type cur_len = sso_size();
+                // leaving sso grows like a full sso buffer, so the next appends do not reallocate again
+                size_type cap = GrowthPolicy::grow(sso_capacity_bytes(), std::max(new_capacity, cur_len + 1));
                 CharT* p = allocate_buffer(cap);
                 // copy from sso.buf to p; sso.buf is bytes; reinterpret as CharT*
                 std::memcpy(p, storage.sso.buf, cur_len); // safe because CharT is 1 byte
                 p[cur_len] = '\0';
                 storage.heap.ptr = p;
                 storage.heap.size = cur_len;
-                storage.heap.cap = cap;
+                set_heap_cap(cap);
                 set_heap_flag();
             }
             else {
@@ -343,6 +1055,32 @@ namespace libsstring {
             }
         }
 
+        // @brief set the length to n within the current buffer and terminate it, after prepare_write()
+        constexpr void set_length(size_type n) noexcept {
+            if (is_sso()) [[likely]] {
+                set_sso_size(n);
+                storage.sso.buf[n] = '\0';
+            }
+            else {
+                storage.heap.size = n;
+                storage.heap.ptr[n] = '\0';
+            }
+        }
+
+        // @brief grow the length from cur by add uninitialized chars and return where they start, after prepare_write()
+        constexpr CharT* extend_uninitialized(size_type cur, size_type add) {
+            const size_type tar = cur + add;
+            if (is_sso() && tar + 1 <= sso_capacity_bytes()) [[likely]] {
+                set_sso_size(tar);
+                storage.sso.buf[tar] = '\0';
+                return reinterpret_cast<CharT*>(storage.sso.buf) + cur;
+            }
+            make_non_sso_and_reserve(tar + 1);
+            storage.heap.size = tar;
+            storage.heap.ptr[tar] = '\0';
+            return storage.heap.ptr + cur;
+        }
+
     public:
         // check little endian support - we currently only support little endian devices
         static_assert(platform_is_little_endian(), "basic_sstring currently assumes little-endian layout for SSO tag trick.");
@@ -367,8 +1105,8 @@ namespace libsstring {
             if (other.is_sso()) [[likely]] {
                 copy_storage(storage, other.storage);
             }
-            // Heap, do allocation
-            else {
+            // Heap, share the buffer when possible, otherwise do allocation
+            else if (!share_heap_from(other)) {
                 size_type sz = other.storage.heap.size;
                 size_type cap = other.heap_capacity_raw();
                 CharT* p = allocate_buffer(cap);
@@ -376,7 +1114,7 @@ namespace libsstring {
                 p[sz] = '\0';
                 storage.heap.ptr = p;
                 storage.heap.size = sz;
-                storage.heap.cap = cap;
+                set_heap_cap(cap);
                 set_heap_flag();
             }
         }
@@ -389,8 +1127,8 @@ namespace libsstring {
             if (other.is_sso()) [[likely]] {
                 copy_storage(storage, other.storage);
             }
-            // Heap, do allocation
-            else {
+            // Heap, share the buffer when possible, otherwise do allocation
+            else if (!share_heap_from(other)) {
                 size_type sz = other.storage.heap.size;
                 size_type cap = other.heap_capacity_raw();
                 CharT* p = allocate_buffer(cap);
@@ -398,7 +1136,7 @@ namespace libsstring {
                 p[sz] = '\0';
                 storage.heap.ptr = p;
                 storage.heap.size = sz;
-                storage.heap.cap = cap;
+                set_heap_cap(cap);
                 set_heap_flag();
             }
         }
@@ -434,7 +1172,7 @@ namespace libsstring {
                     p[sz] = '\0';
                     storage.heap.ptr = p;
                     storage.heap.size = sz;
-                    storage.heap.cap = cap;
+                    set_heap_cap(cap);
                     set_heap_flag();
                 }
             }
@@ -450,8 +1188,8 @@ namespace libsstring {
             // SSO, just copy the storage
             size_type len = Traits::length(s);
             if (len <= sso_max_size()) [[likely]] {
-                storage.sso.len = static_cast<flag_type>(len);
-                storage.sso.tag = 0;
+                set_sso_size(len);
+                clear_heap_flag();
                 std::memcpy(storage.sso.buf, s, len);
                 storage.sso.buf[len] = '\0';
             }
@@ -463,7 +1201,7 @@ namespace libsstring {
                 p[len] = '\0';
                 storage.heap.ptr = p;
                 storage.heap.size = len;
-                storage.heap.cap = cap;
+                set_heap_cap(cap);
                 set_heap_flag();
             }
         }
@@ -479,8 +1217,8 @@ namespace libsstring {
             // SSO, just copy the storage
             size_type len = Traits::length(s);
             if (len <= sso_max_size()) [[likely]] {
-                storage.sso.len = static_cast<flag_type>(len);
-                storage.sso.tag = 0;
+                set_sso_size(len);
+                clear_heap_flag();
                 std::memcpy(storage.sso.buf, s, len);
                 storage.sso.buf[len] = '\0';
             }
@@ -492,7 +1230,7 @@ namespace libsstring {
                 p[len] = '\0';
                 storage.heap.ptr = p;
                 storage.heap.size = len;
-                storage.heap.cap = cap;
+                set_heap_cap(cap);
                 set_heap_flag();
             }
         }
@@ -503,10 +1241,10 @@ namespace libsstring {
             size_type len = sv.size();
             if (len <= sso_max_size()) [[likely]] {
                 // Magic happens: first do the length and then copy the data, performance boosts
-                storage.sso.tag = 0;
+                clear_heap_flag();
                 storage.sso.buf[len] = '\0';
                 std::memcpy(storage.sso.buf, sv.data(), len);
-                storage.sso.len = static_cast<flag_type>(len);
+                set_sso_size(len);
             }
             // dynamically
             else {
@@ -516,7 +1254,7 @@ namespace libsstring {
                 p[len] = '\0';
                 storage.heap.ptr = p;
                 storage.heap.size = len;
-                storage.heap.cap = cap;
+                set_heap_cap(cap);
                 set_heap_flag();
             }
         }
@@ -527,8 +1265,8 @@ namespace libsstring {
             size_type len = sv.size();
             if (len <= sso_max_size()) [[likely]] {
                 // Magic happens: first do the length and then copy the data, performance boosts
-                storage.sso.len = static_cast<flag_type>(len);
-                storage.sso.tag = 0;
+                set_sso_size(len);
+                clear_heap_flag();
                 std::memcpy(storage.sso.buf, sv.data(), len);
                 storage.sso.buf[len] = '\0';
             }
@@ -540,7 +1278,7 @@ namespace libsstring {
                 p[len] = '\0';
                 storage.heap.ptr = p;
                 storage.heap.size = len;
-                storage.heap.cap = cap;
+                set_heap_cap(cap);
                 set_heap_flag();
             }
         }
@@ -552,8 +1290,8 @@ namespace libsstring {
             // SSO, just copy the storage
             if (count <= sso_max_size()) [[likely]] {
                 // Magic happens: first do the length and then copy the data, performance boosts
-                storage.sso.len = static_cast<flag_type>(count);
-                storage.sso.tag = 0;
+                set_sso_size(count);
+                clear_heap_flag();
                 std::memset(storage.sso.buf, static_cast<unsigned char>(ch), count);
                 storage.sso.buf[count] = '\0';
             }
@@ -565,11 +1303,35 @@ namespace libsstring {
                 p[count] = '\0';
                 storage.heap.ptr = p;
                 storage.heap.size = count;
-                storage.heap.cap = cap;
+                set_heap_cap(cap);
                 set_heap_flag();
             }
         }
 
+        // @brief view a null-terminated string of static storage duration without copying it
+        // copies share the view and destruction frees nothing, the first write copies it into an owned buffer
+        // strings that fit SSO are simply copied there
+        static constexpr basic_sstring from_static(const CharT* s, size_type n) noexcept {
+            basic_sstring r;
+            if (n <= sso_max_size()) {
+                std::memcpy(r.storage.sso.buf, s, n);
+                r.storage.sso.buf[n] = '\0';
+                r.set_sso_size(n);
+            }
+            else {
+                r.storage.heap.ptr = const_cast<CharT*>(s);
+                r.storage.heap.size = n;
+                r.set_heap_cap(n + 1);
+                r.set_heap_flag();
+                r.heap_flag_word() |= HEAP_STATIC;
+            }
+            return r;
+        }
+        template<size_type N>
+        static constexpr basic_sstring from_static(const CharT (&lit)[N]) noexcept {
+            return from_static(lit, N - 1);
+        }
+
         // @TODO
         // needs more constructors
 
@@ -581,7 +1343,7 @@ namespace libsstring {
         #endif
             // If not heap, dealloate res
             if (is_heap()) [[unlikely]] {
-                deallocate_buffer(storage.heap.ptr, heap_capacity_raw());
+                release_heap();
             }
         }
 
@@ -592,16 +1354,16 @@ namespace libsstring {
                 return *this;
             }
             // allocator propagation? we do not change allocator on copy assignment
-            if (is_heap()) {
-                size_type cap = heap_capacity_raw();
-                deallocate_buffer(storage.heap.ptr, cap);
-            }
+            // keep our buffer until rhs is taken, rhs may share it
+            Storage old;
+            copy_storage(old, storage);
+            bool_type had_heap = is_heap();
             // SSO, just memcpy
             if (rhs.is_sso()) {
                 copy_storage(storage, rhs.storage);
             }
-            // dynamically
-            else {
+            // share rhs buffer when possible, otherwise dynamically
+            else if (!share_heap_from(rhs)) {
                 size_type sz = rhs.storage.heap.size;
                 size_type cap = rhs.heap_capacity_raw();
                 CharT* p = allocate_buffer(cap);
@@ -609,9 +1371,12 @@ namespace libsstring {
                 p[sz] = '\0';
                 storage.heap.ptr = p;
                 storage.heap.size = sz;
-                storage.heap.cap = cap;
+                set_heap_cap(cap);
                 set_heap_flag();
             }
+            if (had_heap) {
+                release_heap_storage(old);
+            }
             
             return *this;
         }
@@ -625,8 +1390,7 @@ namespace libsstring {
             }
             // deallocate our buffer
             if (is_heap()) {
-                size_type cap = heap_capacity_raw();
-                deallocate_buffer(storage.heap.ptr, cap);
+                release_heap();
             }
             // move allocator if propagate_on_container_move_assignment
             if (alloc_traits::propagate_on_container_move_assignment::value) {
@@ -651,7 +1415,7 @@ namespace libsstring {
                     p[sz] = '\0';
                     storage.heap.ptr = p;
                     storage.heap.size = sz;
-                    storage.heap.cap = cap;
+                    set_heap_cap(cap);
                     set_heap_flag();
                 }
             }
@@ -667,7 +1431,7 @@ namespace libsstring {
 
         // @brief basic query size used
         constexpr size_type size() const noexcept {
-            return is_heap() ? storage.heap.size : storage.sso.len; 
+            return is_heap() ? storage.heap.size : sso_size(); 
         }
 
         // @brief basic query length used
@@ -686,11 +1450,47 @@ namespace libsstring {
         }
 
     public:
+        // @brief hash of the content, heap strings compute it once and keep it until the next write
+        // concurrent const callers all store the same bits with a relaxed fetch_or, and every const reader loads the word atomically
+        size_type hash() const noexcept {
+            if (is_sso()) [[likely]] {
+                return hash_string(storage.sso.buf, sso_size());
+            }
+            if constexpr (HEAP_HASH_VALID == 0) {
+                return hash_string(storage.heap.ptr, storage.heap.size);
+            }
+            else {
+                const size_type f = heap_flag_word();
+                if (f & HEAP_HASH_VALID) {
+                    return f & HEAP_HASH_MASK;
+                }
+                const size_type h = hash_string(storage.heap.ptr, storage.heap.size);
+                // a leaked buffer can change behind our back
+                if (!(f & HEAP_LEAKED)) {
+                    std::atomic_ref<size_type>(storage.heap.flag).fetch_or(HEAP_HASH_VALID | h, std::memory_order_relaxed);
+                }
+                return h;
+            }
+        }
+
+        // @brief true when the string views static storage it does not own
+        constexpr bool is_static() const noexcept {
+            return is_heap() && is_static_heap();
+        }
+
+        // @brief true when the heap buffer is currently shared with other copies, or is static storage
+        constexpr bool is_shared() const noexcept {
+            return is_heap() && !heap_unique();
+        }
+
         // @brief underlying data pointer
         constexpr const CharT* data() const noexcept {
             return is_heap() ? storage.heap.ptr : reinterpret_cast<const CharT*>(storage.sso.buf); 
         }
-        constexpr CharT* data() noexcept {
+        // a shared or static heap buffer is copied first since the caller may write through it, and is never shared again
+        constexpr CharT* data() {
+            prepare_write();
+            leak_heap();
             return is_heap() ? storage.heap.ptr : reinterpret_cast<CharT*>(storage.sso.buf);
         }
         
@@ -701,7 +1501,7 @@ namespace libsstring {
 
     public:
         // @brief random access without index checking
-        constexpr reference operator[](size_type idx) noexcept {
+        constexpr reference operator[](size_type idx) {
             return data()[idx]; 
         }
         constexpr const_reference operator[](size_type idx) const noexcept {
@@ -740,7 +1540,7 @@ namespace libsstring {
 
     public:
         // @brief basic iterators - begin iterator
-        constexpr iterator begin() noexcept {
+        constexpr iterator begin() {
             return data(); 
         }
         constexpr const_iterator begin() const noexcept {
@@ -751,7 +1551,7 @@ namespace libsstring {
         }
 
         // @brief basic iterators - end iterator
-        constexpr iterator end() noexcept {
+        constexpr iterator end() {
             return data() + size(); 
         }
         constexpr const_iterator end() const noexcept {
@@ -762,7 +1562,7 @@ namespace libsstring {
         }
 
         // @brief basic iterators - reverse begin iterator
-        constexpr reverse_iterator rbegin() noexcept {
+        constexpr reverse_iterator rbegin() {
             return reverse_iterator(end());
         }
         constexpr const_reverse_iterator rbegin() const noexcept {
@@ -773,7 +1573,7 @@ namespace libsstring {
         }
 
         // @brief basic iterators - reverse end iterator
-        constexpr reverse_iterator rend() noexcept {
+        constexpr reverse_iterator rend() {
             return reverse_iterator(begin());
         }
         constexpr const_reverse_iterator rend() const noexcept {
@@ -787,11 +1587,20 @@ namespace libsstring {
         // @brief clear the content
         constexpr void clear() noexcept {
             if (is_heap()) [[unlikely]] {
+                // a shared buffer is left to its other holders
+                if (!heap_unique()) {
+                    release_heap();
+                    reset_storage(storage);
+                    return;
+                }
+                forget_hash();
                 storage.heap.size = 0;
                 storage.heap.ptr[0] = '\0';
+                // nothing left to move, reclaim the skipped head for free
+                compact_heap();
             }
             else {
-                storage.sso.len = 0;
+                set_sso_size(0);
                 storage.sso.buf[0] = '\0';
             }
         }
@@ -815,7 +1624,7 @@ namespace libsstring {
         constexpr void reserve_exact(size_type new_cap) {
             // new_cap = chars (excluding null)
             size_type need = new_cap + 1;
-            if (!is_sso()) [[unlikely]] {
+            if (is_sso()) [[likely]] {
                 if (need <= sso_capacity_bytes()) {
                     return;
                 }
@@ -827,13 +1636,13 @@ namespace libsstring {
             }
             // force allocate exactly need (no doubling)
             if (is_sso()) {
-                size_type cur_len = storage.sso.len;
+                size_type cur_len = sso_size();
                 CharT* p = allocate_buffer(need);
                 std::memcpy(p, storage.sso.buf, cur_len);
                 p[cur_len] = '\0';
                 storage.heap.ptr = p;
                 storage.heap.size = cur_len;
-                storage.heap.cap = need;
+                set_heap_cap(need);
                 set_heap_flag();
             }
             else {
@@ -842,10 +1651,9 @@ namespace libsstring {
                 CharT* p = allocate_buffer(need);
                 std::memcpy(p, storage.heap.ptr, storage.heap.size);
                 p[storage.heap.size] = '\0';
-                size_type oldcap = cur_cap;
-                deallocate_buffer(storage.heap.ptr, oldcap);
+                release_heap();
                 storage.heap.ptr = p;
-                storage.heap.cap = need;
+                set_heap_cap(need);
                 set_heap_flag();
             }
         }
@@ -857,24 +1665,41 @@ namespace libsstring {
             }
             size_type sz = storage.heap.size;
             if (sz <= sso_max_size()) {
-                // move back to SSO
-                std::memcpy(storage.sso.buf, storage.heap.ptr, sz);
-                storage.sso.len = static_cast<flag_type>(sz);
+                // move back to SSO, the sso bytes overlap the heap fields so keep them first
+                Storage old;
+                copy_storage(old, storage);
+                std::memcpy(storage.sso.buf, old.heap.ptr, sz);
+                set_sso_size(sz);
                 storage.sso.buf[sz] = '\0';
-                size_type oldcap = heap_capacity_raw();
-                deallocate_buffer(storage.heap.ptr, oldcap);
-                storage.sso.tag = 0;
+                clear_heap_flag();
+                release_heap_storage(old);
             }
             else {
                 size_type newcap = sz + 1;
-                size_type oldcap = heap_capacity_raw();
+                size_type oldcap = heap_capacity_raw() + heap_offset();
+                #if _SSTRING_ENABLE_MREMAP != 0
+                // a mapped block that stays huge hands its tail pages straight back to the os
+                if constexpr (HeapMapped) {
+                    if (oldcap >= HEAP_MAP_THRESHOLD && newcap >= HEAP_MAP_THRESHOLD && heap_unique()) {
+                        compact_heap();
+                        size_type old_bytes = oldcap + HEAP_BLOCK_HEADER;
+                        size_type bytes = newcap + HEAP_BLOCK_HEADER;
+                        if (page_round(bytes) < old_bytes) {
+                            byte_type* block = static_cast<byte_type*>(remap_pages(storage.heap.ptr - HEAP_BLOCK_HEADER, old_bytes, bytes));
+                            storage.heap.ptr = reinterpret_cast<CharT*>(block + HEAP_BLOCK_HEADER);
+                            set_heap_cap(bytes - HEAP_BLOCK_HEADER);
+                        }
+                        return;
+                    }
+                }
+                #endif
                 if (newcap < oldcap) {
                     CharT* p = allocate_buffer(newcap);
                     std::memcpy(p, storage.heap.ptr, sz);
                     p[sz] = '\0';
-                    deallocate_buffer(storage.heap.ptr, oldcap);
+                    release_heap();
                     storage.heap.ptr = p;
-                    storage.heap.cap = newcap;
+                    set_heap_cap(newcap);
                     set_heap_flag();
                 }
             }
@@ -884,11 +1709,12 @@ namespace libsstring {
         constexpr void push_back(CharT ch) {
             size_type cur = size();
             size_type need = cur + 2;
+            prepare_write(need);
             // currently SSO Mode
             if (is_sso()) [[likely]] {
                 // SSO already good
                 if (cur < sso_max_size()) [[likely]] {
-                    storage.sso.len = static_cast<flag_type>(cur + 1);
+                    set_sso_size(cur + 1);
                     storage.sso.buf[cur] = static_cast<unsigned char>(ch);
                     storage.sso.buf[cur + 1] = '\0';
                 }
@@ -917,10 +1743,11 @@ namespace libsstring {
             if (cur == 0) [[unlikely]] {
                 return;
             }
+            prepare_write();
             size_type tar = cur - 1;
             if (is_sso()) [[likely]] {
                 storage.sso.buf[tar] = '\0';
-                storage.sso.len = static_cast<flag_type>(tar);
+                set_sso_size(tar);
             }
             else {
                 storage.heap.ptr[tar] = '\0';
@@ -934,10 +1761,11 @@ namespace libsstring {
             if (new_size == cur) {
                 return;
             }
+            prepare_write(new_size + 1);
             // shrink
             if (new_size < cur) [[unlikely]] {
                 if (is_sso()) [[likely]] {
-                    storage.sso.len = static_cast<flag_type>(new_size);
+                    set_sso_size(new_size);
                     storage.sso.buf[new_size] = '\0';
                 }
                 else {
@@ -946,14 +1774,77 @@ namespace libsstring {
                 }
                 return;
             }
-            // enlarge
+            // enlarge, stays in SSO when the result fits
             else {
-                size_type need = new_size + 1;
-                make_non_sso_and_reserve(need);
-                std::fill(storage.heap.ptr + cur, storage.heap.ptr + new_size, ch);
-                storage.heap.size = new_size;
-                storage.heap.ptr[new_size] = '\0';
+                CharT* p = extend_uninitialized(cur, new_size - cur);
+                std::memset(p, static_cast<unsigned char>(ch), new_size - cur);
+            }
+        }
+
+        // @brief append n chars left uninitialized and return them for the caller to fill
+        constexpr std::span<CharT> append_uninitialized(size_type n) {
+            const size_type cur = size();
+            prepare_write(cur + n + 1);
+            CharT* p = extend_uninitialized(cur, n);
+            leak_heap();
+            return std::span<CharT>(p, n);
+        }
+
+        // @brief resize to n without initializing, then let op(data, n) write and return the final length
+        // like C++23 std::basic_string::resize_and_overwrite, the first min(size(), n) chars are kept
+        template<typename Operation>
+        constexpr void resize_and_overwrite(size_type n, Operation op) {
+            const size_type cur = size();
+            prepare_write(n + 1);
+            if (n > cur) {
+                extend_uninitialized(cur, n - cur);
+            }
+            leak_heap();
+            CharT* p = is_heap() ? storage.heap.ptr : reinterpret_cast<CharT*>(storage.sso.buf);
+            const size_type r = static_cast<size_type>(std::move(op)(p, n));
+            if (r > n) [[unlikely]] {
+                throw std::out_of_range("resize_and_overwrite length");
+            }
+            set_length(r);
+        }
+
+        // @brief append the decimal form of a number, formatted in place without a temporary string
+        // integers are sized exactly first, floats use the shortest round-trip form of std::to_chars
+        template<sstring_number T>
+        constexpr basic_sstring& append_number(T value) {
+            const size_type cur = size();
+            prepare_write();
+            if constexpr (std::is_integral_v<T>) {
+                const size_type n = integer_chars(value);
+                write_integer(reinterpret_cast<char*>(extend_uninitialized(cur, n)), n, value);
+            }
+            else {
+                constexpr size_type max_n = number_max_chars<T>();
+                // worst case fits the tail, format there and trim
+                if (capacity() - cur >= max_n) [[likely]] {
+                    char* p = reinterpret_cast<char*>(extend_uninitialized(cur, max_n));
+                    const auto r = std::to_chars(p, p + max_n, value);
+                    set_length(cur + static_cast<size_type>(r.ptr - p));
+                }
+                // otherwise size it on the stack so an SSO string does not leave SSO for nothing
+                else {
+                    char tmp[max_n];
+                    const auto r = std::to_chars(tmp, tmp + max_n, value);
+                    append(std::basic_string_view<CharT, Traits>(reinterpret_cast<const CharT*>(tmp), static_cast<size_type>(r.ptr - tmp)));
+                }
             }
+            return *this;
+        }
+
+        // @brief parse the whole string as a number, throws std::invalid_argument or std::out_of_range
+        template<sstring_number T>
+        T parse() const {
+            return parse_number<T>(std::string_view(reinterpret_cast<const char*>(data()), size()));
+        }
+        // @brief parse the whole string as a number, false when it is not one
+        template<sstring_number T>
+        bool parse(T& value) const noexcept {
+            return parse_number(std::string_view(reinterpret_cast<const char*>(data()), size()), value);
         }
 
         // @brief append a string to the back of current string
@@ -962,19 +1853,20 @@ namespace libsstring {
             const size_type cur = size();
             const size_type tar = cur + add;
             const size_type need = tar + 1;
+            prepare_write(need);
             // sso mode and do not need to reserve
             if (is_sso() && need <= sso_capacity_bytes()) [[likely]] {
                 std::memcpy(storage.sso.buf + cur, sv.data(), add);
                 storage.sso.buf[tar] = '\0';
-                storage.sso.len = static_cast<flag_type>(tar);
+                set_sso_size(tar);
                 return *this;
             }
             // non-sso mode
             else {
                 make_non_sso_and_reserve(need);
                 std::memcpy(storage.heap.ptr + cur, sv.data(), add);
-                storage.heap.ptr[storage.heap.size] = '\0';
                 storage.heap.size = tar;
+                storage.heap.ptr[tar] = '\0';
                 return *this;
             }
         }
@@ -1019,11 +1911,12 @@ namespace libsstring {
             size_type add = sv.size();
             size_type cur = size();
             size_type need = cur + add + 1;
+            prepare_write(need);
             // SSO mode and no need to reallocate
             if (is_sso() && need <= sso_capacity_bytes()) [[likely]] {
                 std::memmove(storage.sso.buf + pos + add, storage.sso.buf + pos, cur - pos);
                 std::memcpy(storage.sso.buf + pos, sv.data(), add);
-                storage.sso.len = static_cast<flag_type>(cur + add);
+                set_sso_size(cur + add);
                 storage.sso.buf[cur + add] = '\0';
                 return *this;
             }
@@ -1046,21 +1939,25 @@ namespace libsstring {
             }
             // earse all
             if (len == npos || pos + len >= cur) {
-                if (is_sso()) [[likely]] {
-                    storage.sso.len = static_cast<flag_type>(pos);
-                    storage.sso.buf[pos] = '\0';
+                if (pos == 0) {
+                    clear();
                 }
                 else {
-                    storage.heap.size = pos;
-                    storage.heap.ptr[pos] = '\0';
+                    drop_back(cur - pos);
                 }
                 return *this;
             }
+            // erase a prefix, O(1) for heap strings
+            if (pos == 0) {
+                drop_front(len);
+                return *this;
+            }
             // erase some
+            prepare_write();
             size_type tail = cur - (pos + len);
             if (is_sso()) [[likely]] {
                 std::memmove(storage.sso.buf + pos, storage.sso.buf + pos + len, tail);
-                storage.sso.len = static_cast<flag_type>(pos + tail);
+                set_sso_size(pos + tail);
                 storage.sso.buf[pos + tail] = '\0';
             }
             else {
@@ -1071,36 +1968,145 @@ namespace libsstring {
             return *this;
         }
         
-        // @brief operator+ concat two strings
-        constexpr basic_sstring operator+(const CharT* b) {
-            basic_sstring r;
-            r.reserve(size() + Traits::length(b));
-            r.append(std::basic_string_view<CharT, Traits>(data(), size()));
-            r.append(b);
-            return r;
+        // @brief remove n chars from the front, heap strings just advance their start offset
+        constexpr void remove_prefix(size_type n) {
+            if (n > size()) [[unlikely]] {
+                throw std::out_of_range("remove_prefix count");
+            }
+            drop_front(n);
         }
-        constexpr basic_sstring operator+(const basic_sstring& b) {
-            basic_sstring r;
-            r.reserve(size() + b.size());
-            r.append(std::basic_string_view<CharT, Traits>(data(), size()));
-            r.append(std::basic_string_view<CharT, Traits>(b.data(), b.size()));
-            return r;
+
+        // @brief remove n chars from the back
+        constexpr void remove_suffix(size_type n) {
+            if (n > size()) [[unlikely]] {
+                throw std::out_of_range("remove_suffix count");
+            }
+            drop_back(n);
         }
-        constexpr basic_sstring operator+(std::basic_string_view<CharT, Traits> b) {
-            basic_sstring r;
-            r.reserve(size() + b.size());
-            r.append(std::basic_string_view<CharT, Traits>(data(), size()));
-            r.append(b);
-            return r;
+
+        // @brief append several pieces after sizing the result once
+        constexpr basic_sstring& append_pieces(const std::basic_string_view<CharT, Traits>* pieces, size_type n) {
+            size_type add = 0;
+            for (size_type i = 0; i < n; ++i) {
+                add += pieces[i].size();
+            }
+            const size_type cur = size();
+            const size_type tar = cur + add;
+            prepare_write(tar + 1);
+            CharT* out;
+            if (is_sso() && tar + 1 <= sso_capacity_bytes()) [[likely]] {
+                out = reinterpret_cast<CharT*>(storage.sso.buf);
+                set_sso_size(tar);
+            }
+            else {
+                if (!is_sso() && heap_capacity_raw() >= tar + 1) {
+                    out = storage.heap.ptr;
+                }
+                else {
+                    // growing frees the old buffer, so pieces viewing it are materialized first
+                    const CharT* lo = data();
+                    const CharT* hi = lo + cur;
+                    for (size_type i = 0; i < n; ++i) {
+                        if (!std::less<const CharT*>{}(pieces[i].data(), lo) && std::less<const CharT*>{}(pieces[i].data(), hi)) {
+                            basic_sstring tmp;
+                            tmp.append_pieces(pieces, n);
+                            return append(std::basic_string_view<CharT, Traits>(tmp.data(), tmp.size()));
+                        }
+                    }
+                    // a fresh string gets exactly its size, a growing one follows the growth policy
+                    if (cur == 0 && is_sso()) {
+                        reserve_exact(add);
+                    }
+                    else {
+                        make_non_sso_and_reserve(tar + 1);
+                    }
+                    out = storage.heap.ptr;
+                }
+                storage.heap.size = tar;
+            }
+            size_type at = cur;
+            for (size_type i = 0; i < n; ++i) {
+                std::memcpy(out + at, pieces[i].data(), pieces[i].size());
+                at += pieces[i].size();
+            }
+            out[tar] = '\0';
+            return *this;
+        }
+
+        // @brief append every piece with one reservation, a piece is anything that views as a string
+        template<typename... Pieces>
+            requires (sizeof...(Pieces) > 0)
+        constexpr basic_sstring& append_concat(const Pieces&... pieces) {
+            const std::basic_string_view<CharT, Traits> views[] = { std::basic_string_view<CharT, Traits>(pieces)... };
+            return append_pieces(views, sizeof...(Pieces));
         }
-        constexpr friend basic_sstring operator+(std::basic_string_view<CharT, Traits> a, const basic_sstring& b) {
+
+        // @brief concatenate every piece into a new string sized once, a + b + c + d without the intermediate growth
+        template<typename... Pieces>
+            requires (sizeof...(Pieces) > 0)
+        [[nodiscard]] static constexpr basic_sstring concat(const Pieces&... pieces) {
             basic_sstring r;
-            r.reserve(a.size() + b.size());
-            r.append(a);
-            r.append(std::basic_string_view<CharT, Traits>(b.data(), b.size()));
+            r.append_concat(pieces...);
             return r;
         }
 
+        // @brief insert a in front of the expiring b, a piece that views b itself is concatenated into a new string
+        static constexpr basic_sstring prepend_into(std::basic_string_view<CharT, Traits> a, basic_sstring&& b) {
+            const CharT* p = std::as_const(b).data();
+            const std::less_equal<const CharT*> le;
+            if (le(p, a.data()) && le(a.data(), p + b.size())) {
+                return concat(a, std::basic_string_view<CharT, Traits>(b));
+            }
+            b.insert(0, a);
+            return std::move(b);
+        }
+
+        // @brief operator+ concat two strings into a new one sized once, chains reuse the expiring left operand
+        [[nodiscard]] friend constexpr basic_sstring operator+(const basic_sstring& a, const basic_sstring& b) {
+            return concat(a, b);
+        }
+        [[nodiscard]] friend constexpr basic_sstring operator+(const basic_sstring& a, std::basic_string_view<CharT, Traits> b) {
+            return concat(a, b);
+        }
+        [[nodiscard]] friend constexpr basic_sstring operator+(std::basic_string_view<CharT, Traits> a, const basic_sstring& b) {
+            return concat(a, b);
+        }
+        [[nodiscard]] friend constexpr basic_sstring operator+(const basic_sstring& a, const CharT* b) {
+            return concat(a, b);
+        }
+        [[nodiscard]] friend constexpr basic_sstring operator+(const CharT* a, const basic_sstring& b) {
+            return concat(a, b);
+        }
+
+        // @brief operator+ on an expiring left operand appends into its buffer
+        friend constexpr basic_sstring operator+(basic_sstring&& a, const basic_sstring& b) {
+            a.append(std::basic_string_view<CharT, Traits>(b));
+            return std::move(a);
+        }
+        friend constexpr basic_sstring operator+(basic_sstring&& a, std::basic_string_view<CharT, Traits> b) {
+            a.append(b);
+            return std::move(a);
+        }
+        friend constexpr basic_sstring operator+(basic_sstring&& a, const CharT* b) {
+            a.append(b);
+            return std::move(a);
+        }
+        friend constexpr basic_sstring operator+(basic_sstring&& a, basic_sstring&& b) {
+            a.append(std::basic_string_view<CharT, Traits>(b));
+            return std::move(a);
+        }
+
+        // @brief operator+ on an expiring right operand prepends into its buffer
+        friend constexpr basic_sstring operator+(const basic_sstring& a, basic_sstring&& b) {
+            return prepend_into(std::basic_string_view<CharT, Traits>(a), std::move(b));
+        }
+        friend constexpr basic_sstring operator+(std::basic_string_view<CharT, Traits> a, basic_sstring&& b) {
+            return prepend_into(a, std::move(b));
+        }
+        friend constexpr basic_sstring operator+(const CharT* a, basic_sstring&& b) {
+            return prepend_into(std::basic_string_view<CharT, Traits>(a), std::move(b));
+        }
+
         // @brief get a substring of curent string
         constexpr basic_sstring substr(size_type pos = 0, size_type count = npos) const {
             size_type cur = size();
@@ -1124,7 +2130,7 @@ namespace libsstring {
             const unsigned char* hay = reinterpret_cast<const unsigned char*>(data() + pos);
             const unsigned char* end = reinterpret_cast<const unsigned char*>(data() + n);
 
-            const void* p = std::memchr(hay, ch, end - hay);
+            const void* p = simd_memchr(hay, static_cast<unsigned char>(ch), end - hay);
             if (!p) {
                 return npos;
             }
@@ -1138,28 +2144,12 @@ namespace libsstring {
                 return npos;
             }
 
-            const unsigned char* hay = reinterpret_cast<const unsigned char*>(data() + pos);
-            const unsigned char* end = reinterpret_cast<const unsigned char*>(data() + n - 1); // Ensures 2 chars
-
-            while (hay < end) {
-                // find the 1st by memchr
-                const void* p = std::memchr(hay, ch1, end - hay);
-                if (!p) {
-                    return npos;
-                }
-
-                size_type idx = static_cast<size_type>(reinterpret_cast<const CharT*>(p) - data());
-
-                // Check next 
-                if (data()[idx + 1] == ch2) {
-                    return idx;
-                }
-
-                // Go on and on
-                hay = reinterpret_cast<const unsigned char*>(p) + 1;
+            // both characters are matched in one pass
+            const void* p = simd_find_pair(data() + pos, static_cast<unsigned char>(ch1), static_cast<unsigned char>(ch2), n - pos);
+            if (!p) {
+                return npos;
             }
-
-            return npos;
+            return static_cast<size_type>(reinterpret_cast<const CharT*>(p) - data());
         }
 
         // @brief find a string from a position
@@ -1176,37 +2166,25 @@ namespace libsstring {
             else if (m > n - pos) [[unlikely]] {
                 return npos;
             }
-            else if (m > 64) {
-                return find_bmh(sv, pos);
-            }
-
-            const CharT* hay = data() + pos;
-            const CharT* const hay_end = data() + n;
-            const CharT* needle = sv.data();
-            const CharT first = needle[0];
-
-            const std::size_t remaining = n - pos;
-            const std::size_t search_len = remaining - m + 1;
-
-            const unsigned char* cur = reinterpret_cast<const unsigned char*>(hay);
-            const unsigned char* end = cur + search_len;
 
-            while (true) {
-                const void* p = std::memchr(cur, first, end - cur);
-                if (!p) {
-                    return npos;
-                }
-
-                const CharT* candidate = reinterpret_cast<const CharT*>(p);
-                if (Traits::compare(candidate, needle, m) == 0) {
-                    return static_cast<size_type>(candidate - data());
-                }
+            const void* p = find_bytes(data() + pos, n - pos, sv.data(), m);
+            if (!p) {
+                return npos;
+            }
+            return static_cast<size_type>(reinterpret_cast<const CharT*>(p) - data());
+        }
 
-                cur = reinterpret_cast<const unsigned char*>(candidate + 1);
-                if (cur >= end) {
-                    return npos;
-                }
+        // @brief find with a precompiled searcher from a position
+        constexpr size_type find(const basic_sstring_searcher<CharT, Traits>& searcher, size_type pos = 0) const noexcept {
+            const size_type n = size();
+            if (pos > n) [[unlikely]] {
+                return npos;
+            }
+            const CharT* p = searcher.search(data() + pos, n - pos);
+            if (!p) {
+                return npos;
             }
+            return static_cast<size_type>(p - data());
         }
 
         // @brief bmh find a string from a position
@@ -1269,11 +2247,141 @@ namespace libsstring {
             return static_cast<size_type>(p - data());
         }
 
+        // @brief find the first character in a charset from a position
+        constexpr size_type find_first_of(const basic_sstring_charset<CharT, Traits>& set, size_type pos = 0) const noexcept {
+            const size_type n = size();
+            if (pos >= n) {
+                return npos;
+            }
+            const CharT* p = set.scan(data() + pos, n - pos, true);
+            return p ? static_cast<size_type>(p - data()) : npos;
+        }
+        constexpr size_type find_first_of(std::basic_string_view<CharT, Traits> chars, size_type pos = 0) const noexcept {
+            if (chars.size() == 1) {
+                return find(chars[0], pos);
+            }
+            return find_first_of(basic_sstring_charset<CharT, Traits>(chars), pos);
+        }
+        constexpr size_type find_first_of(CharT ch, size_type pos = 0) const noexcept {
+            return find(ch, pos);
+        }
+
+        // @brief find the first character not in a charset from a position
+        constexpr size_type find_first_not_of(const basic_sstring_charset<CharT, Traits>& set, size_type pos = 0) const noexcept {
+            const size_type n = size();
+            if (pos >= n) {
+                return npos;
+            }
+            const CharT* p = set.scan(data() + pos, n - pos, false);
+            return p ? static_cast<size_type>(p - data()) : npos;
+        }
+        constexpr size_type find_first_not_of(std::basic_string_view<CharT, Traits> chars, size_type pos = 0) const noexcept {
+            return find_first_not_of(basic_sstring_charset<CharT, Traits>(chars), pos);
+        }
+        constexpr size_type find_first_not_of(CharT ch, size_type pos = 0) const noexcept {
+            return find_first_not_of(basic_sstring_charset<CharT, Traits>().add(ch), pos);
+        }
+
+        // @brief find the last character in a charset at or before a position
+        constexpr size_type find_last_of(const basic_sstring_charset<CharT, Traits>& set, size_type pos = npos) const noexcept {
+            const size_type n = size();
+            if (n == 0) {
+                return npos;
+            }
+            const CharT* p = set.rscan(data(), pos >= n ? n : pos + 1, true);
+            return p ? static_cast<size_type>(p - data()) : npos;
+        }
+        constexpr size_type find_last_of(std::basic_string_view<CharT, Traits> chars, size_type pos = npos) const noexcept {
+            return find_last_of(basic_sstring_charset<CharT, Traits>(chars), pos);
+        }
+        constexpr size_type find_last_of(CharT ch, size_type pos = npos) const noexcept {
+            return find_last_of(basic_sstring_charset<CharT, Traits>().add(ch), pos);
+        }
+
+        // @brief find the last character not in a charset at or before a position
+        constexpr size_type find_last_not_of(const basic_sstring_charset<CharT, Traits>& set, size_type pos = npos) const noexcept {
+            const size_type n = size();
+            if (n == 0) {
+                return npos;
+            }
+            const CharT* p = set.rscan(data(), pos >= n ? n : pos + 1, false);
+            return p ? static_cast<size_type>(p - data()) : npos;
+        }
+        constexpr size_type find_last_not_of(std::basic_string_view<CharT, Traits> chars, size_type pos = npos) const noexcept {
+            return find_last_not_of(basic_sstring_charset<CharT, Traits>(chars), pos);
+        }
+        constexpr size_type find_last_not_of(CharT ch, size_type pos = npos) const noexcept {
+            return find_last_not_of(basic_sstring_charset<CharT, Traits>().add(ch), pos);
+        }
+
+        // @brief length of the run of characters in a charset starting at a position
+        constexpr size_type span_while(const basic_sstring_charset<CharT, Traits>& set, size_type pos = 0) const noexcept {
+            const size_type n = size();
+            if (pos >= n) {
+                return 0;
+            }
+            const CharT* p = set.scan(data() + pos, n - pos, false);
+            return p ? static_cast<size_type>(p - (data() + pos)) : n - pos;
+        }
+        constexpr size_type span_while(std::basic_string_view<CharT, Traits> chars, size_type pos = 0) const noexcept {
+            return span_while(basic_sstring_charset<CharT, Traits>(chars), pos);
+        }
+
+        // @brief length of the run of characters not in a charset starting at a position
+        constexpr size_type span_until(const basic_sstring_charset<CharT, Traits>& set, size_type pos = 0) const noexcept {
+            const size_type n = size();
+            if (pos >= n) {
+                return 0;
+            }
+            const CharT* p = set.scan(data() + pos, n - pos, true);
+            return p ? static_cast<size_type>(p - (data() + pos)) : n - pos;
+        }
+        constexpr size_type span_until(std::basic_string_view<CharT, Traits> chars, size_type pos = 0) const noexcept {
+            return span_until(basic_sstring_charset<CharT, Traits>(chars), pos);
+        }
+
+        // @brief lazily split on a character, the pieces are views into this string and die with its next mutation
+        // splitting an expiring string would hand out views of a dead buffer, so rvalues are rejected
+        basic_sstring_split_char<CharT, Traits> split(CharT delim) const& noexcept {
+            return basic_sstring_split_char<CharT, Traits>(to_std_string_view(), split_on_char<CharT, Traits>(delim));
+        }
+        void split(CharT delim) const&& = delete;
+
+        // @brief lazily split on a string delimiter, an empty delimiter yields the whole string
+        basic_sstring_split_string<CharT, Traits> split(std::basic_string_view<CharT, Traits> delim) const& {
+            return basic_sstring_split_string<CharT, Traits>(to_std_string_view(), split_on_string<CharT, Traits>(delim));
+        }
+        void split(std::basic_string_view<CharT, Traits> delim) const&& = delete;
+
+        // @brief lazily split on any character of a set
+        basic_sstring_split_any<CharT, Traits> split_any(const basic_sstring_charset<CharT, Traits>& set) const& noexcept {
+            return basic_sstring_split_any<CharT, Traits>(to_std_string_view(), split_on_any<CharT, Traits>(set));
+        }
+        basic_sstring_split_any<CharT, Traits> split_any(std::basic_string_view<CharT, Traits> chars) const& noexcept {
+            return split_any(basic_sstring_charset<CharT, Traits>(chars));
+        }
+        void split_any(const basic_sstring_charset<CharT, Traits>& set) const&& = delete;
+        void split_any(std::basic_string_view<CharT, Traits> chars) const&& = delete;
+
+        // @brief split into a container of strings, e.g. std::vector<basic_sstring>, sized once up front
+        template <typename Container>
+        Container& split_to(Container& out, CharT delim) const {
+            return split(delim).split_to(out);
+        }
+        template <typename Container>
+        Container& split_to(Container& out, std::basic_string_view<CharT, Traits> delim) const {
+            return split(delim).split_to(out);
+        }
+        template <typename Container>
+        Container& split_to(Container& out, const basic_sstring_charset<CharT, Traits>& set) const {
+            return split_any(set).split_to(out);
+        }
+
         // @brief compare with another string
         constexpr int compare(std::basic_string_view<CharT, Traits> sv) const noexcept {
             size_type lhs_sz = size();
             size_type rhs_sz = sv.size();
-            int r = std::memcmp(data(), sv.data(), std::min(lhs_sz, rhs_sz));
+            int r = simd_memcmp(data(), sv.data(), std::min(lhs_sz, rhs_sz));
             if (r != 0) {
                 return r;
             }
@@ -1324,52 +2432,61 @@ namespace libsstring {
         }
 
         // @brief trim a basic_sstring from left as a string_view
-        constexpr std::basic_string_view<CharT, Traits> ltrim_view(std::basic_string_view<CharT, Traits> chars = " \t\r\n") const noexcept {
-            size_type i = 0;
-            while (i < size() && chars.find(data()[i]) != std::basic_string_view<CharT, Traits>::npos) {
-                ++i;
-            }
+        constexpr std::basic_string_view<CharT, Traits> ltrim_view(const basic_sstring_charset<CharT, Traits>& set) const noexcept {
+            const size_type i = span_while(set);
             return std::basic_string_view<CharT, Traits>(data() + i, size() - i);
         }
+        constexpr std::basic_string_view<CharT, Traits> ltrim_view(std::basic_string_view<CharT, Traits> chars = " \t\r\n") const noexcept {
+            return ltrim_view(basic_sstring_charset<CharT, Traits>(chars));
+        }
 
         // @brief trim a basic_sstring from right as a string_view
+        constexpr std::basic_string_view<CharT, Traits> rtrim_view(const basic_sstring_charset<CharT, Traits>& set) const noexcept {
+            const CharT* p = set.rscan(data(), size(), false);
+            return std::basic_string_view<CharT, Traits>(data(), p ? static_cast<size_type>(p - data()) + 1 : 0);
+        }
         constexpr std::basic_string_view<CharT, Traits> rtrim_view(std::basic_string_view<CharT, Traits> chars = " \t\r\n") const noexcept {
-            size_type i = size();
-            while (i > 0 && chars.find(data()[i - 1]) != std::basic_string_view<CharT, Traits>::npos) {
-                --i;
-            }
-            return std::basic_string_view<CharT, Traits>(data(), i);
+            return rtrim_view(basic_sstring_charset<CharT, Traits>(chars));
         }
 
         // @brief trim a basic_sstring from both sideas a string_view
-        constexpr std::basic_string_view<CharT, Traits> trim_view(std::basic_string_view<CharT, Traits> chars = " \t\r\n") const noexcept {
-            auto left = ltrim_view(chars);
-            std::basic_string_view<CharT, Traits> right(chars);
-
-            size_type end = left.size();
-            const CharT* ptr = left.data();
-            while (end > 0 && right.find(ptr[end - 1]) != std::basic_string_view<CharT, Traits>::npos) {
-                --end;
+        constexpr std::basic_string_view<CharT, Traits> trim_view(const basic_sstring_charset<CharT, Traits>& set) const noexcept {
+            const size_type n = size();
+            const size_type left = span_while(set);
+            if (left == n) {
+                return std::basic_string_view<CharT, Traits>(data() + n, 0);
             }
-            return std::basic_string_view<CharT, Traits>(ptr, end);
+            // data()[left] is outside the set, so the reverse scan always stops inside [left, n)
+            const CharT* p = set.rscan(data() + left, n - left, false);
+            return std::basic_string_view<CharT, Traits>(data() + left, static_cast<size_type>(p - (data() + left)) + 1);
+        }
+        constexpr std::basic_string_view<CharT, Traits> trim_view(std::basic_string_view<CharT, Traits> chars = " \t\r\n") const noexcept {
+            return trim_view(basic_sstring_charset<CharT, Traits>(chars));
         }
 
         // @brief inplace trim a basic_sstring from left
-        constexpr void ltrim(std::basic_string_view<CharT, Traits> chars = " \t\r\n") noexcept {
-            auto v = ltrim_view(chars);
-            this->assign(v.begin(), v.end());
+        constexpr void ltrim(const basic_sstring_charset<CharT, Traits>& set) {
+            drop_front(span_while(set));
+        }
+        constexpr void ltrim(std::basic_string_view<CharT, Traits> chars = " \t\r\n") {
+            ltrim(basic_sstring_charset<CharT, Traits>(chars));
         }
 
         // @brief inplace trim a basic_sstring from right
-        constexpr void rtrim(std::basic_string_view<CharT, Traits> chars = " \t\r\n") noexcept {
-            auto v = rtrim_view(chars);
-            this->assign(v.begin(), v.end());
+        constexpr void rtrim(const basic_sstring_charset<CharT, Traits>& set) {
+            drop_back(size() - rtrim_view(set).size());
+        }
+        constexpr void rtrim(std::basic_string_view<CharT, Traits> chars = " \t\r\n") {
+            rtrim(basic_sstring_charset<CharT, Traits>(chars));
         }
 
         // @brief inplace trim a basic_sstring from both side
-        constexpr void trim(std::basic_string_view<CharT, Traits> chars = " \t\r\n") noexcept {
-            auto v = trim_view(chars);
-            this->assign(v.begin(), v.end());
+        constexpr void trim(const basic_sstring_charset<CharT, Traits>& set) {
+            rtrim(set);
+            ltrim(set);
+        }
+        constexpr void trim(std::basic_string_view<CharT, Traits> chars = " \t\r\n") {
+            trim(basic_sstring_charset<CharT, Traits>(chars));
         }
 
     public:
@@ -1401,7 +2518,7 @@ namespace libsstring {
     public:
         // @brief generic compare (in content)
         friend auto operator<=>(const basic_sstring& a, const basic_sstring& b) noexcept {
-            const auto cmp = Traits::compare(a.data(), b.data(), std::min(a.size(), b.size()));
+            const auto cmp = traits_compare(a.data(), b.data(), std::min(a.size(), b.size()));
             if (cmp != 0) {
                 return cmp <=> 0;
             }
@@ -1410,11 +2527,29 @@ namespace libsstring {
 
         // @brief compare equality (in content)
         friend bool operator==(const basic_sstring& a, const basic_sstring& b) noexcept {
-            return a.size() == b.size() && Traits::compare(a.data(), b.data(), a.size()) == 0;
+            return a.size() == b.size() && traits_compare(a.data(), b.data(), a.size()) == 0;
         }
         friend bool operator!=(const basic_sstring& a, const basic_sstring& b) noexcept { 
             return !(a == b);
         }
+
+        // @brief compare against a string_view or C-string without building a temporary
+        friend auto operator<=>(const basic_sstring& a, std::basic_string_view<CharT, Traits> b) noexcept {
+            const auto cmp = traits_compare(a.data(), b.data(), std::min(a.size(), b.size()));
+            if (cmp != 0) {
+                return cmp <=> 0;
+            }
+            return a.size() <=> b.size();
+        }
+        friend bool operator==(const basic_sstring& a, std::basic_string_view<CharT, Traits> b) noexcept {
+            return a.size() == b.size() && traits_compare(a.data(), b.data(), a.size()) == 0;
+        }
+        friend auto operator<=>(const basic_sstring& a, const CharT* b) noexcept {
+            return a <=> std::basic_string_view<CharT, Traits>(b);
+        }
+        friend bool operator==(const basic_sstring& a, const CharT* b) noexcept {
+            return a == std::basic_string_view<CharT, Traits>(b);
+        }
     };
 
     // convenience alias for char basic sstring
@@ -1423,5 +2558,69 @@ namespace libsstring {
     // convenience alias for char basic string with pmr
     using sstring_pmr = basic_sstring<char, std::char_traits<char>, std::pmr::polymorphic_allocator<char>, std::uint8_t, 30, 16>;
 
+    // convenience alias for char basic sstring sharing only heap buffers of 4 KiB and more, smaller ones are copied
+    using sstring_tiered = basic_sstring<char, std::char_traits<char>, std::allocator<char>, std::uint8_t, 30, 16, share_large<>>;
+
+    // convenience alias for char basic sstring in the compact 24-byte layout, 23 chars stay inline
+    using sstring24 = basic_sstring<char, std::char_traits<char>, std::allocator<char>, std::uint8_t, 23, 8>;
+
+    // convenience alias for char basic sstring sharing heap buffers copy-on-write
+    using sstring_cow = basic_sstring<char, std::char_traits<char>, std::allocator<char>, std::uint8_t, 30, 16, share_cow>;
+
+    // User-defined literals
+    inline namespace literals {
+
+        // @brief "..."_ss views the literal without allocating, see basic_sstring::from_static
+        inline sstring operator""_ss(const char* s, std::size_t n) noexcept {
+            return sstring::from_static(s, n);
+        }
+
+    }
+
+    // @brief decimal form of a number as an sstring, short results never allocate
+    template<sstring_number T>
+    sstring to_sstring(T value) {
+        sstring s;
+        s.append_number(value);
+        return s;
+    }
+
+    // Transparent hash for unordered containers, heap sstrings reuse their memoized hash
+    // probing with a string_view, std::string or C-string hashes the same chars without a temporary sstring
+    struct hash {
+        using is_transparent = void;
+
+        template<typename CharT, typename Traits, typename Alloc, typename Flag, size_t Reserved, size_t Align, typename Share, typename Growth>
+        size_t operator()(const basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>& s) const noexcept {
+            return s.hash();
+        }
+        size_t operator()(std::string_view sv) const noexcept {
+            return hash_string(sv.data(), sv.size());
+        }
+    };
+
+    // Transparent equality over sstrings, string_views, std::strings and C-strings
+    struct equal_to {
+        using is_transparent = void;
+
+        template<typename A, typename B>
+        constexpr bool operator()(const A& a, const B& b) const noexcept {
+            const std::string_view x(a), y(b);
+            return x.size() == y.size() && simd::memcmp(x.data(), y.data(), x.size()) == 0;
+        }
+    };
+
+    // Transparent ordering over sstrings, string_views, std::strings and C-strings
+    struct less {
+        using is_transparent = void;
+
+        template<typename A, typename B>
+        constexpr bool operator()(const A& a, const B& b) const noexcept {
+            const std::string_view x(a), y(b);
+            const int cmp = simd::memcmp(x.data(), y.data(), std::min(x.size(), y.size()));
+            return cmp < 0 || (cmp == 0 && x.size() < y.size());
+        }
+    };
+
 }
 // namespace libsstring ends
@@ -0,0 +1,284 @@
+// sstring_arena.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "sstring.hpp"
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // Bump-pointer arena for request scoped strings, single threaded, everything is released by reset()
+    class arena_resource {
+    private:
+        // chunk header, the usable bytes follow it
+        struct chunk {
+            chunk* next;                         // older chunk
+            std::size_t size;                    // usable bytes after the header
+        };
+
+        static constexpr std::size_t CHUNK_ALIGN = alignof(std::max_align_t);
+        static constexpr std::size_t HEADER_BYTES = (sizeof(chunk) + CHUNK_ALIGN - 1) & ~(CHUNK_ALIGN - 1);
+        static constexpr std::size_t MAX_CHUNK_BYTES = std::size_t(16) << 20;
+
+        chunk* head_ = nullptr;                  // current chunk, the newest
+        unsigned char* cur_ = nullptr;           // bump pointer
+        unsigned char* end_ = nullptr;           // end of the current chunk
+        unsigned char* last_ = nullptr;          // start of the most recent allocation, nullptr when unknown
+        std::size_t next_chunk_;                 // usable bytes of the next chunk, doubles up to MAX_CHUNK_BYTES
+        std::size_t used_ = 0;                   // bytes handed out since the last reset
+        std::size_t reserved_ = 0;               // bytes held in chunks
+
+        // thread's current arena, see arena_scope
+        static arena_resource*& current_ref() noexcept {
+            static thread_local arena_resource* current = nullptr;
+            return current;
+        }
+
+        // @brief start a new chunk able to hold bytes at align
+        void grow(std::size_t bytes, std::size_t align) {
+            std::size_t size = std::max(next_chunk_, bytes + align);
+            chunk* c = static_cast<chunk*>(::operator new(HEADER_BYTES + size));
+            c->next = head_;
+            c->size = size;
+            head_ = c;
+            cur_ = reinterpret_cast<unsigned char*>(c) + HEADER_BYTES;
+            end_ = cur_ + size;
+            last_ = nullptr;
+            reserved_ += size;
+            next_chunk_ = std::min(next_chunk_ * 2, MAX_CHUNK_BYTES);
+        }
+
+        // @brief bump pointer rounded up to align
+        static unsigned char* align_up(unsigned char* p, std::size_t align) noexcept {
+            return reinterpret_cast<unsigned char*>((reinterpret_cast<std::uintptr_t>(p) + align - 1) & ~(std::uintptr_t(align) - 1));
+        }
+
+    public:
+        // @brief construct an empty arena, the first chunk is allocated on first use
+        explicit arena_resource(std::size_t initial_chunk = 64 * 1024) noexcept : next_chunk_(std::max<std::size_t>(initial_chunk, 256)) {}
+
+        arena_resource(const arena_resource&) = delete;
+        arena_resource& operator=(const arena_resource&) = delete;
+
+        // @brief free every chunk
+        ~arena_resource() {
+            release();
+        }
+
+        // @brief bump allocate bytes at align
+        void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+            unsigned char* p = align_up(cur_, align);
+            if (!cur_ || p > end_ || static_cast<std::size_t>(end_ - p) < bytes) [[unlikely]] {
+                grow(bytes, align);
+                p = align_up(cur_, align);
+            }
+            last_ = p;
+            cur_ = p + bytes;
+            used_ += bytes;
+            return p;
+        }
+
+        // @brief make room for bytes of unaligned allocations in the current chunk, starting one new chunk at most
+        void reserve(std::size_t bytes) {
+            if (!cur_ || static_cast<std::size_t>(end_ - cur_) < bytes) {
+                grow(bytes, 1);
+            }
+        }
+
+        // @brief no-op, except that the most recent allocation is rolled back
+        void deallocate(void* p, std::size_t bytes) noexcept {
+            if (p == last_ && last_ + bytes == cur_) {
+                cur_ = last_;
+                last_ = nullptr;
+                used_ -= bytes;
+            }
+        }
+
+        // @brief grow the most recent allocation in place when the chunk still has room
+        bool try_extend(void* p, std::size_t old_bytes, std::size_t new_bytes) noexcept {
+            if (p != last_ || last_ + old_bytes != cur_ || static_cast<std::size_t>(end_ - last_) < new_bytes) {
+                return false;
+            }
+            cur_ = last_ + new_bytes;
+            used_ += new_bytes - old_bytes;
+            return true;
+        }
+
+        // @brief drop every allocation at once, the newest chunk is kept for reuse
+        void reset() noexcept {
+            if (!head_) {
+                return;
+            }
+            chunk* keep = head_;
+            chunk* c = keep->next;
+            while (c) {
+                chunk* next = c->next;
+                reserved_ -= c->size;
+                ::operator delete(c);
+                c = next;
+            }
+            keep->next = nullptr;
+            cur_ = reinterpret_cast<unsigned char*>(keep) + HEADER_BYTES;
+            end_ = cur_ + keep->size;
+            last_ = nullptr;
+            used_ = 0;
+        }
+
+        // @brief give every chunk back
+        void release() noexcept {
+            chunk* c = head_;
+            while (c) {
+                chunk* next = c->next;
+                ::operator delete(c);
+                c = next;
+            }
+            head_ = nullptr;
+            cur_ = end_ = last_ = nullptr;
+            used_ = reserved_ = 0;
+        }
+
+        // @brief basic statistics
+        std::size_t bytes_used() const noexcept {
+            return used_;
+        }
+        std::size_t bytes_reserved() const noexcept {
+            return reserved_;
+        }
+
+        // @brief arena installed on this thread by the innermost arena_scope, nullptr when none
+        static arena_resource* current() noexcept {
+            return current_ref();
+        }
+
+        friend class arena_scope;
+    };
+
+    // Scope guard installing an arena as the thread's current arena, restores the previous one on exit
+    class arena_scope {
+    private:
+        arena_resource* prev_;
+
+    public:
+        explicit arena_scope(arena_resource& arena) noexcept : prev_(std::exchange(arena_resource::current_ref(), &arena)) {}
+        ~arena_scope() {
+            arena_resource::current_ref() = prev_;
+        }
+
+        arena_scope(const arena_scope&) = delete;
+        arena_scope& operator=(const arena_scope&) = delete;
+    };
+
+    // Allocator over an arena_resource, default constructed it binds the thread's current arena
+    // with no arena installed it falls back to operator new so strings outside any scope still work
+    template<typename T>
+    class arena_allocator {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using is_always_equal = std::false_type;
+
+    private:
+        arena_resource* arena_;
+
+        template<typename U>
+        friend class arena_allocator;
+
+    public:
+        // @brief bind the thread's current arena
+        arena_allocator() noexcept : arena_(arena_resource::current()) {}
+
+        // @brief bind an explicit arena
+        arena_allocator(arena_resource& arena) noexcept : arena_(&arena) {}
+
+        // @brief rebind copy
+        template<typename U>
+        arena_allocator(const arena_allocator<U>& other) noexcept : arena_(other.arena_) {}
+
+        // @brief allocate n elements from the arena
+        T* allocate(size_type n) {
+            if (!arena_) [[unlikely]] {
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            }
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        // @brief nothing to free, only the newest block is rolled back
+        void deallocate(T* p, size_type n) noexcept {
+            if (!arena_) [[unlikely]] {
+                ::operator delete(p);
+                return;
+            }
+            arena_->deallocate(p, n * sizeof(T));
+        }
+
+        // @brief grow the newest block in place, basic_sstring tries this before reallocating
+        bool try_extend(T* p, size_type old_n, size_type new_n) noexcept {
+            return arena_ && arena_->try_extend(p, old_n * sizeof(T), new_n * sizeof(T));
+        }
+
+        // @brief bound arena, nullptr for operator new
+        arena_resource* arena() const noexcept {
+            return arena_;
+        }
+
+        friend bool operator==(const arena_allocator& a, const arena_allocator& b) noexcept {
+            return a.arena_ == b.arena_;
+        }
+    };
+
+    // convenience alias for char basic sstring allocated from an arena
+    using sstring_arena = basic_sstring<char, std::char_traits<char>, arena_allocator<char>, std::uint8_t, 30, 16>;
+
+    // @brief split into a container of arena strings, e.g. std::vector<sstring_arena>, in one scan of the text
+    // only pieces past the sso buffer allocate, size + 1 bytes each, so the text length plus one terminator per possible
+    // heap piece bounds them all and the arena is presized once for that before the first piece is built
+    template<typename Container, typename CharT, typename Traits, typename Delim>
+    Container& split_to(const basic_sstring_split_view<CharT, Traits, Delim>& pieces, Container& out, arena_resource& arena) {
+        using string_type = typename Container::value_type;
+        const std::size_t n = pieces.text().size();
+        const std::size_t inline_chars = string_type().capacity();
+        arena.reserve((n + n / (inline_chars + 1) + 1) * sizeof(CharT));
+        const arena_allocator<CharT> alloc(arena);
+        for (auto it = pieces.begin(); it != pieces.end(); ++it) {
+            out.emplace_back(*it, alloc);
+        }
+        return out;
+    }
+
+}
+// namespace libsstring ends
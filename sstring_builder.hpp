@@ -0,0 +1,346 @@
+// sstring_builder.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+#if defined(__has_include)
+#if __has_include(<format>)
+#include <format>
+#endif
+#endif
+
+#include "sstring.hpp"
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // Chunked string builder, appends go into a list of chunks and written bytes never move
+    template<
+        typename CharT = char,
+        typename Traits = std::char_traits<CharT>,
+        typename Allocator = std::allocator<CharT>
+    >
+    class basic_sstring_builder {
+        static_assert(sizeof(CharT) == 1, "basic_sstring_builder currently supports only byte-sized CharT, aka. char");
+    // Public types
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using string_view_type = std::basic_string_view<CharT, Traits>;
+
+        // chunks double from the first chunk size up to this
+        static constexpr size_type max_chunk = size_type(1) << 20;
+
+    private:
+        // chunk header, the chars follow it
+        struct chunk {
+            chunk* next;                         // newer chunk
+            size_type size;                      // chars written, final once a newer chunk exists
+            size_type cap;                       // chars available
+        };
+
+        using word_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<size_type>;
+        using word_alloc_traits = std::allocator_traits<word_alloc_type>;
+        static constexpr size_type HEADER_WORDS = (sizeof(chunk) + sizeof(size_type) - 1) / sizeof(size_type);
+
+        word_alloc_type alloc_;
+        chunk* head_ = nullptr;                  // oldest chunk
+        chunk* tail_ = nullptr;                  // chunk being written
+        CharT* cur_ = nullptr;                   // write position in tail_
+        CharT* end_ = nullptr;                   // end of tail_
+        size_type done_ = 0;                     // chars in every chunk before tail_
+        size_type next_chunk_;                   // capacity of the next chunk
+
+        // @brief chars of a chunk
+        static CharT* chunk_data(chunk* c) noexcept {
+            return reinterpret_cast<CharT*>(reinterpret_cast<size_type*>(c) + HEADER_WORDS);
+        }
+        static const CharT* chunk_data(const chunk* c) noexcept {
+            return reinterpret_cast<const CharT*>(reinterpret_cast<const size_type*>(c) + HEADER_WORDS);
+        }
+        static constexpr size_type chunk_words(size_type cap) noexcept {
+            return HEADER_WORDS + (cap + sizeof(size_type) - 1) / sizeof(size_type);
+        }
+
+        // @brief close the tail chunk and start one holding at least n chars
+        void add_chunk(size_type n) {
+            const size_type cap = std::max(n, next_chunk_);
+            chunk* c = reinterpret_cast<chunk*>(word_alloc_traits::allocate(alloc_, chunk_words(cap)));
+            c->next = nullptr;
+            c->size = 0;
+            c->cap = cap;
+            if (tail_) {
+                tail_->size = static_cast<size_type>(cur_ - chunk_data(tail_));
+                done_ += tail_->size;
+                tail_->next = c;
+            }
+            else {
+                head_ = c;
+            }
+            tail_ = c;
+            cur_ = chunk_data(c);
+            end_ = cur_ + cap;
+            next_chunk_ = std::min(next_chunk_ * 2, max_chunk);
+        }
+
+        // @brief free every chunk
+        void free_chunks() noexcept {
+            chunk* c = head_;
+            while (c) {
+                chunk* next = c->next;
+                word_alloc_traits::deallocate(alloc_, reinterpret_cast<size_type*>(c), chunk_words(c->cap));
+                c = next;
+            }
+            head_ = tail_ = nullptr;
+            cur_ = end_ = nullptr;
+            done_ = 0;
+        }
+
+        // @brief chars written into a chunk
+        size_type chunk_size(const chunk* c) const noexcept {
+            return c == tail_ ? static_cast<size_type>(cur_ - chunk_data(tail_)) : c->size;
+        }
+
+    public:
+        // Output iterator writing straight into the tail chunk, a new chunk starts only when the tail is full
+        class output_iterator {
+            basic_sstring_builder* b_;
+
+        public:
+            using iterator_category = std::output_iterator_tag;
+            using value_type = void;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = void;
+
+            explicit output_iterator(basic_sstring_builder& b) noexcept : b_(&b) {}
+
+            // @brief write one char at the tail
+            output_iterator& operator=(CharT ch) {
+                if (b_->cur_ == b_->end_) [[unlikely]] {
+                    b_->add_chunk(1);
+                }
+                *b_->cur_++ = ch;
+                return *this;
+            }
+
+            // @brief write a whole string with chunk sized copies
+            output_iterator& operator=(string_view_type sv) {
+                b_->append(sv);
+                return *this;
+            }
+
+            output_iterator& operator*() noexcept {
+                return *this;
+            }
+            output_iterator& operator++() noexcept {
+                return *this;
+            }
+            output_iterator& operator++(int) noexcept {
+                return *this;
+            }
+        };
+
+    public:
+        // @brief construct an empty builder, the first chunk is allocated on the first write
+        explicit basic_sstring_builder(size_type first_chunk = 4096, const Allocator& alloc = Allocator())
+            : alloc_(alloc), next_chunk_(std::max<size_type>(first_chunk, 64)) {}
+
+        basic_sstring_builder(const basic_sstring_builder&) = delete;
+        basic_sstring_builder& operator=(const basic_sstring_builder&) = delete;
+
+        // @brief take over the chunks of other
+        basic_sstring_builder(basic_sstring_builder&& other) noexcept
+            : alloc_(std::move(other.alloc_)), head_(std::exchange(other.head_, nullptr)), tail_(std::exchange(other.tail_, nullptr)),
+              cur_(std::exchange(other.cur_, nullptr)), end_(std::exchange(other.end_, nullptr)), done_(std::exchange(other.done_, 0)),
+              next_chunk_(other.next_chunk_) {}
+        basic_sstring_builder& operator=(basic_sstring_builder&& other) noexcept {
+            if (this != &other) {
+                free_chunks();
+                alloc_ = std::move(other.alloc_);
+                head_ = std::exchange(other.head_, nullptr);
+                tail_ = std::exchange(other.tail_, nullptr);
+                cur_ = std::exchange(other.cur_, nullptr);
+                end_ = std::exchange(other.end_, nullptr);
+                done_ = std::exchange(other.done_, 0);
+                next_chunk_ = other.next_chunk_;
+            }
+            return *this;
+        }
+
+        ~basic_sstring_builder() {
+            free_chunks();
+        }
+
+    public:
+        // @brief basic queries
+        size_type size() const noexcept {
+            return tail_ ? done_ + static_cast<size_type>(cur_ - chunk_data(tail_)) : 0;
+        }
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        // @brief drop the content and every chunk
+        void clear() noexcept {
+            free_chunks();
+        }
+
+        // @brief append a string, filling the tail chunk before starting a new one
+        basic_sstring_builder& append(string_view_type sv) {
+            const CharT* p = sv.data();
+            size_type n = sv.size();
+            while (n != 0) {
+                if (cur_ == end_) [[unlikely]] {
+                    add_chunk(n);
+                }
+                const size_type k = std::min(n, static_cast<size_type>(end_ - cur_));
+                std::memcpy(cur_, p, k);
+                cur_ += k;
+                p += k;
+                n -= k;
+            }
+            return *this;
+        }
+        basic_sstring_builder& append(const CharT* s) {
+            return append(string_view_type(s));
+        }
+
+        // @brief append count copies of ch
+        basic_sstring_builder& append(size_type count, CharT ch) {
+            while (count != 0) {
+                if (cur_ == end_) [[unlikely]] {
+                    add_chunk(count);
+                }
+                const size_type k = std::min(count, static_cast<size_type>(end_ - cur_));
+                std::memset(cur_, static_cast<unsigned char>(ch), k);
+                cur_ += k;
+                count -= k;
+            }
+            return *this;
+        }
+
+        // @brief append one char
+        void push_back(CharT ch) {
+            if (cur_ == end_) [[unlikely]] {
+                add_chunk(1);
+            }
+            *cur_++ = ch;
+        }
+
+        // @brief operator+= to append
+        basic_sstring_builder& operator+=(string_view_type sv) {
+            return append(sv);
+        }
+        basic_sstring_builder& operator+=(const CharT* s) {
+            return append(s);
+        }
+        basic_sstring_builder& operator+=(CharT ch) {
+            push_back(ch);
+            return *this;
+        }
+
+        // @brief n contiguous writable chars at the end, publish what was written with commit()
+        CharT* prepare(size_type n) {
+            if (static_cast<size_type>(end_ - cur_) < n) {
+                add_chunk(n);
+            }
+            return cur_;
+        }
+        void commit(size_type n) noexcept {
+            cur_ += n;
+        }
+
+        // @brief output iterator over the chunks, std::format_to and std::copy targets
+        output_iterator out() noexcept {
+            return output_iterator(*this);
+        }
+
+        #if defined(__cpp_lib_format)
+        // @brief format straight into the tail chunk, bulk writes through a contiguous pointer
+        template<typename... Args>
+        basic_sstring_builder& format(std::basic_format_string<CharT, std::type_identity_t<Args>...> fmt, Args&&... args) {
+            const size_type room = static_cast<size_type>(end_ - cur_);
+            const auto r = std::format_to_n(cur_, static_cast<std::ptrdiff_t>(room), fmt, std::forward<Args>(args)...);
+            const size_type n = static_cast<size_type>(r.size);
+            if (n > room) {
+                // the partial output is left behind in the closed chunk
+                CharT* p = prepare(n);
+                std::format_to(p, fmt, std::forward<Args>(args)...);
+            }
+            cur_ += n;
+            return *this;
+        }
+        #endif
+
+        // @brief visit every chunk in order, no copy, e.g. to feed writev
+        template<typename Fn>
+        void for_each_chunk(Fn&& fn) const {
+            for (const chunk* c = head_; c; c = c->next) {
+                const size_type n = chunk_size(c);
+                if (n != 0) {
+                    fn(string_view_type(chunk_data(c), n));
+                }
+            }
+        }
+
+        // @brief views of every chunk in order, valid until the builder is written, cleared or destroyed
+        std::vector<string_view_type> chunks() const {
+            std::vector<string_view_type> views;
+            for_each_chunk([&views](string_view_type v) { views.push_back(v); });
+            return views;
+        }
+
+        // @brief copy everything into one string with a single allocation
+        template<typename String = basic_sstring<CharT, Traits, Allocator>>
+        String finish() const {
+            String r;
+            r.reserve(size());
+            for_each_chunk([&r](string_view_type v) { r.append(v); });
+            return r;
+        }
+    };
+
+    // convenience alias for char builder
+    using sstring_builder = basic_sstring_builder<char, std::char_traits<char>>;
+
+}
+// namespace libsstring ends
@@ -0,0 +1,180 @@
+// sstring_charconv.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // two ascii digits for every value below 100
+    inline constexpr char digit_pairs[201] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    // numbers sstring formats and parses, bool and character types excluded
+    template<typename T>
+    concept sstring_number = std::is_arithmetic_v<T> && !std::is_same_v<std::remove_cv_t<T>, bool>
+        && !std::is_same_v<std::remove_cv_t<T>, char> && !std::is_same_v<std::remove_cv_t<T>, wchar_t>
+        && !std::is_same_v<std::remove_cv_t<T>, char8_t> && !std::is_same_v<std::remove_cv_t<T>, char16_t>
+        && !std::is_same_v<std::remove_cv_t<T>, char32_t>;
+
+    // @brief most chars to_chars may produce for T in its shortest form
+    template<typename T>
+    consteval std::size_t number_max_chars() noexcept {
+        if constexpr (std::is_integral_v<T>) {
+            return std::numeric_limits<T>::digits10 + 1 + std::is_signed_v<T>;
+        }
+        else {
+            // sign, max_digits10 digits, point, 'e', exponent sign and digits
+            return 4 + std::numeric_limits<T>::max_digits10 + (std::numeric_limits<T>::max_exponent10 >= 1000 ? 4 : 3);
+        }
+    }
+
+    // @brief decimal digits of an unsigned value
+    template<typename U>
+    constexpr unsigned count_digits(U v) noexcept {
+        unsigned n = 1;
+        for (;;) {
+            if (v < 10) return n;
+            if (v < 100) return n + 1;
+            if (v < 1000) return n + 2;
+            if (v < 10000) return n + 3;
+            v /= 10000u;
+            n += 4;
+        }
+    }
+
+    // @brief write v backwards ending at end, two digits per step, end - begin must equal count_digits(v)
+    template<typename U>
+    constexpr void write_digits(char* end, U v) noexcept {
+        while (v >= 100) {
+            const unsigned r = static_cast<unsigned>(v % 100);
+            v /= 100;
+            end -= 2;
+            end[0] = digit_pairs[r * 2];
+            end[1] = digit_pairs[r * 2 + 1];
+        }
+        if (v >= 10) {
+            end -= 2;
+            end[0] = digit_pairs[v * 2];
+            end[1] = digit_pairs[v * 2 + 1];
+        }
+        else {
+            *--end = static_cast<char>('0' + v);
+        }
+    }
+
+    // @brief exact length of the decimal form of an integer
+    template<typename T>
+    constexpr std::size_t integer_chars(T v) noexcept {
+        using U = std::make_unsigned_t<T>;
+        if constexpr (std::is_signed_v<T>) {
+            if (v < 0) {
+                return 1 + count_digits(static_cast<U>(U(0) - static_cast<U>(v)));
+            }
+        }
+        return count_digits(static_cast<U>(v));
+    }
+
+    // @brief write the decimal form of an integer into exactly integer_chars(v) chars at p
+    template<typename T>
+    constexpr void write_integer(char* p, std::size_t n, T v) noexcept {
+        using U = std::make_unsigned_t<T>;
+        U u = static_cast<U>(v);
+        if constexpr (std::is_signed_v<T>) {
+            if (v < 0) {
+                *p = '-';
+                u = U(0) - u;
+            }
+        }
+        write_digits(p + n, u);
+    }
+
+    // @brief parse the whole of text as a number, false on junk, trailing chars or overflow
+    template<sstring_number T>
+    bool parse_number(std::string_view text, T& value) noexcept {
+        const char* first = text.data();
+        const char* last = first + text.size();
+        const auto r = std::from_chars(first, last, value);
+        return r.ec == std::errc() && r.ptr == last;
+    }
+
+    // @brief parse the whole of text as a number, throws like std::stoi does
+    template<sstring_number T>
+    T parse_number(std::string_view text) {
+        T value{};
+        const char* first = text.data();
+        const char* last = first + text.size();
+        const auto r = std::from_chars(first, last, value);
+        if (r.ec == std::errc::result_out_of_range) [[unlikely]] {
+            throw std::out_of_range("parse");
+        }
+        if (r.ec != std::errc() || r.ptr != last) [[unlikely]] {
+            throw std::invalid_argument("parse");
+        }
+        return value;
+    }
+
+    // @brief parse a column of numbers separated by delim into out, in one pass without splitting
+    // a trailing delimiter is allowed, an empty or malformed field throws std::invalid_argument
+    template<sstring_number T, typename OutputIt>
+    OutputIt parse_column(std::string_view text, char delim, OutputIt out) {
+        const char* p = text.data();
+        const char* last = p + text.size();
+        while (p != last) {
+            T value{};
+            const auto r = std::from_chars(p, last, value);
+            if (r.ec == std::errc::result_out_of_range) [[unlikely]] {
+                throw std::out_of_range("parse_column");
+            }
+            if (r.ec != std::errc() || (r.ptr != last && *r.ptr != delim)) [[unlikely]] {
+                throw std::invalid_argument("parse_column");
+            }
+            *out = value;
+            ++out;
+            p = r.ptr == last ? last : r.ptr + 1;
+        }
+        return out;
+    }
+
+}
+// namespace libsstring ends
@@ -0,0 +1,339 @@
+// sstring_file.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cerrno>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+#include <filesystem>
+#include <utility>
+
+#include "sstring.hpp"
+
+// define sstring file helpers use posix open/read/mmap
+#ifndef _SSTRING_ENABLE_MMAP_FILE
+#if defined(__unix__) || defined(__APPLE__)
+#define _SSTRING_ENABLE_MMAP_FILE          1
+#else
+#define _SSTRING_ENABLE_MMAP_FILE          0
+#endif
+#endif
+
+#if _SSTRING_ENABLE_MMAP_FILE != 0
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // @brief throw the current errno as std::system_error
+    [[noreturn]] inline void throw_file_error(const char* what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // @brief read a whole file into a string sized up front, the bytes are read straight into its buffer
+    // files that report no size (pipes, procfs) are read in doubling steps until end of file
+    template<typename String = sstring>
+    String load_file(const std::filesystem::path& path) {
+        String s;
+        #if _SSTRING_ENABLE_MMAP_FILE != 0
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw_file_error("load_file open");
+        }
+        // closes on every exit path, sizing the string may throw
+        struct fd_closer {
+            int fd;
+            ~fd_closer() {
+                ::close(fd);
+            }
+        } closer{ fd };
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            throw_file_error("load_file stat");
+        }
+        #if defined(POSIX_FADV_SEQUENTIAL)
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        #endif
+        const bool sized = st.st_size > 0;
+        std::size_t want = sized ? static_cast<std::size_t>(st.st_size) : std::size_t(4096);
+        std::size_t got = 0;
+        int err = 0;
+        for (;;) {
+            s.resize_and_overwrite(want, [&](char* p, std::size_t n) {
+                while (got < n) {
+                    const ::ssize_t r = ::read(fd, p + got, n - got);
+                    if (r < 0) {
+                        if (errno == EINTR) continue;
+                        err = errno;
+                        break;
+                    }
+                    if (r == 0) break;
+                    got += static_cast<std::size_t>(r);
+                }
+                return got;
+            });
+            if (err != 0 || got < want || sized) break;
+            want *= 2;
+        }
+        if (err != 0) {
+            errno = err;
+            throw_file_error("load_file read");
+        }
+        #else
+        std::FILE* f = std::fopen(path.string().c_str(), "rb");
+        if (!f) {
+            throw_file_error("load_file open");
+        }
+        // closes on every exit path, sizing the string may throw
+        struct file_closer {
+            std::FILE* f;
+            ~file_closer() {
+                std::fclose(f);
+            }
+        } closer{ f };
+        std::error_code ec;
+        const std::uintmax_t bytes = std::filesystem::file_size(path, ec);
+        const bool sized = !ec && bytes > 0;
+        std::size_t want = sized ? static_cast<std::size_t>(bytes) : std::size_t(4096);
+        std::size_t got = 0;
+        for (;;) {
+            s.resize_and_overwrite(want, [&](char* p, std::size_t n) {
+                got += std::fread(p + got, 1, n - got, f);
+                return got;
+            });
+            if (got < want || sized) break;
+            want *= 2;
+        }
+        if (std::ferror(f) != 0) {
+            throw_file_error("load_file read");
+        }
+        #endif
+        return s;
+    }
+
+    #if _SSTRING_ENABLE_MMAP_FILE != 0
+    // Mapping hints for mapped_file_view
+    struct mapped_file_options {
+        bool sequential = true;                  // MADV_SEQUENTIAL, aggressive read-ahead and early page reuse
+        bool populate = false;                   // prefault every page at map time (MAP_POPULATE on linux)
+        std::size_t readahead = 0;               // bytes from the start to MADV_WILLNEED right away
+    };
+
+    // Read-only mapping of a whole file, lines and records are string_views into the mapping and nothing is copied
+    // views stay valid while the mapping lives
+    class mapped_file_view {
+    public:
+        using options = mapped_file_options;
+
+        // Forward iterator over records ending in a delimiter, found with the SIMD memchr kernel
+        // the last record may lack its delimiter, a trailing delimiter does not add an empty record
+        class record_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view*;
+            using reference = const std::string_view&;
+
+            record_iterator() noexcept = default;
+            record_iterator(const char* first, const char* last, char delim) noexcept
+                : last_(last), delim_(delim) {
+                if (first != last) {
+                    scan(first);
+                }
+            }
+
+            reference operator*() const noexcept {
+                return rec_;
+            }
+            pointer operator->() const noexcept {
+                return &rec_;
+            }
+            record_iterator& operator++() noexcept {
+                const char* next = rec_.data() + rec_.size();
+                if (next == last_ || ++next == last_) {
+                    rec_ = std::string_view();
+                }
+                else {
+                    scan(next);
+                }
+                return *this;
+            }
+            record_iterator operator++(int) noexcept {
+                record_iterator old = *this;
+                ++*this;
+                return old;
+            }
+            // records start at distinct addresses, the end iterator holds a null view
+            friend bool operator==(const record_iterator& a, const record_iterator& b) noexcept {
+                return a.rec_.data() == b.rec_.data();
+            }
+
+        private:
+            const char* last_ = nullptr;
+            std::string_view rec_;
+            char delim_ = '\n';
+
+            // @brief take the record starting at p
+            void scan(const char* p) noexcept {
+                const void* hit = simd::memchr(p, static_cast<unsigned char>(delim_), static_cast<std::size_t>(last_ - p));
+                const char* stop = hit ? static_cast<const char*>(hit) : last_;
+                rec_ = std::string_view(p, static_cast<std::size_t>(stop - p));
+            }
+        };
+
+        // begin/end pair for range-for
+        struct record_range {
+            record_iterator first;
+            record_iterator last;
+            record_iterator begin() const noexcept { return first; }
+            record_iterator end() const noexcept { return last; }
+        };
+
+    private:
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+
+    public:
+        mapped_file_view() noexcept = default;
+
+        // @brief map path read-only, an empty file maps nothing and views as empty
+        explicit mapped_file_view(const std::filesystem::path& path, options opt = {}) {
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                throw_file_error("mapped_file_view open");
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                const int err = errno;
+                ::close(fd);
+                errno = err;
+                throw_file_error("mapped_file_view stat");
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ != 0) {
+                int flags = MAP_PRIVATE;
+                #if defined(MAP_POPULATE)
+                if (opt.populate) {
+                    flags |= MAP_POPULATE;
+                }
+                #endif
+                void* p = ::mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+                if (p == MAP_FAILED) {
+                    const int err = errno;
+                    ::close(fd);
+                    errno = err;
+                    size_ = 0;
+                    throw_file_error("mapped_file_view mmap");
+                }
+                data_ = static_cast<const char*>(p);
+                if (opt.sequential) {
+                    ::madvise(p, size_, MADV_SEQUENTIAL);
+                }
+                if (opt.readahead != 0) {
+                    ::madvise(p, std::min(opt.readahead, size_), MADV_WILLNEED);
+                }
+            }
+            // the mapping keeps the file alive
+            ::close(fd);
+        }
+
+        mapped_file_view(const mapped_file_view&) = delete;
+        mapped_file_view& operator=(const mapped_file_view&) = delete;
+
+        mapped_file_view(mapped_file_view&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+        mapped_file_view& operator=(mapped_file_view&& other) noexcept {
+            if (this != &other) {
+                unmap();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+            }
+            return *this;
+        }
+
+        ~mapped_file_view() {
+            unmap();
+        }
+
+    public:
+        // @brief basic queries
+        const char* data() const noexcept {
+            return data_;
+        }
+        std::size_t size() const noexcept {
+            return size_;
+        }
+        bool empty() const noexcept {
+            return size_ == 0;
+        }
+        std::string_view view() const noexcept {
+            return std::string_view(data_, size_);
+        }
+
+        // @brief records separated by delim
+        record_range records(char delim) const noexcept {
+            return record_range{ record_iterator(data_, data_ + size_, delim), record_iterator() };
+        }
+        // @brief lines separated by '\n', the newline is not part of the view
+        record_range lines() const noexcept {
+            return records('\n');
+        }
+
+        // @brief hint that [offset, offset + length) is needed soon
+        void will_need(std::size_t offset, std::size_t length) const noexcept {
+            if (offset < size_) {
+                // madvise wants a page aligned start
+                const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+                const std::size_t start = offset & ~(page - 1);
+                ::madvise(const_cast<char*>(data_) + start, std::min(length, size_ - offset) + (offset - start), MADV_WILLNEED);
+            }
+        }
+
+        // @brief release the mapping early
+        void unmap() noexcept {
+            if (data_) {
+                ::munmap(const_cast<char*>(data_), size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+    };
+    #endif
+
+}
+// namespace libsstring ends
@@ -0,0 +1,150 @@
+// sstring_hash.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // width of sstring hashes, 64-bit targets keep 51 bits so a heap string can memoize a whole hash
+    // in the free bits of its flag word, narrower targets have no memo and use every bit of size_t
+    inline constexpr std::size_t hash_bits = sizeof(std::size_t) >= 8 ? 51 : sizeof(std::size_t) * 8;
+
+    // wyhash secrets
+    inline constexpr std::uint64_t hash_secret[4] = {
+        0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+    };
+
+    // @brief 64x64 -> 128 multiply, low half into a and high half into b
+    inline void hash_mum(std::uint64_t& a, std::uint64_t& b) noexcept {
+        #if defined(__SIZEOF_INT128__)
+        __uint128_t r = static_cast<__uint128_t>(a) * b;
+        a = static_cast<std::uint64_t>(r);
+        b = static_cast<std::uint64_t>(r >> 64);
+        #elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+        #else
+        std::uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<std::uint32_t>(a), lb = static_cast<std::uint32_t>(b);
+        std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+        std::uint64_t c = t < rl;
+        std::uint64_t lo = t + (rm1 << 32);
+        c += lo < t;
+        std::uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        a = lo;
+        b = hi;
+        #endif
+    }
+
+    // @brief multiply and fold the halves
+    inline std::uint64_t hash_mix(std::uint64_t a, std::uint64_t b) noexcept {
+        hash_mum(a, b);
+        return a ^ b;
+    }
+
+    // @brief unaligned little-endian loads
+    inline std::uint64_t hash_read8(const unsigned char* p) noexcept {
+        std::uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+    inline std::uint64_t hash_read4(const unsigned char* p) noexcept {
+        std::uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    // @brief wyhash of n bytes, fast non-cryptographic 64-bit hash
+    inline std::uint64_t hash_bytes(const void* data, std::size_t n, std::uint64_t seed = 0) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        seed ^= hash_mix(seed ^ hash_secret[0], hash_secret[1]);
+        std::uint64_t a, b;
+        // short keys, which covers every sso string, are two overlapping loads
+        if (n <= 16) [[likely]] {
+            if (n >= 4) [[likely]] {
+                const std::size_t q = (n >> 3) << 2;
+                a = (hash_read4(p) << 32) | hash_read4(p + q);
+                b = (hash_read4(p + n - 4) << 32) | hash_read4(p + n - 4 - q);
+            }
+            else if (n > 0) {
+                a = (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[n >> 1]) << 8) | p[n - 1];
+                b = 0;
+            }
+            else {
+                a = b = 0;
+            }
+        }
+        else {
+            std::size_t i = n;
+            if (i >= 48) [[unlikely]] {
+                std::uint64_t see1 = seed, see2 = seed;
+                do {
+                    seed = hash_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+                    see1 = hash_mix(hash_read8(p + 16) ^ hash_secret[2], hash_read8(p + 24) ^ see1);
+                    see2 = hash_mix(hash_read8(p + 32) ^ hash_secret[3], hash_read8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i >= 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                seed = hash_mix(hash_read8(p) ^ hash_secret[1], hash_read8(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            a = hash_read8(p + i - 16);
+            b = hash_read8(p + i - 8);
+        }
+        a ^= hash_secret[1];
+        b ^= seed;
+        hash_mum(a, b);
+        return hash_mix(a ^ hash_secret[0] ^ n, b ^ hash_secret[1]);
+    }
+
+    // @brief the sstring hash of n bytes, hash_bytes folded to hash_bits
+    inline std::size_t hash_string(const void* data, std::size_t n) noexcept {
+        const std::uint64_t h = hash_bytes(data, n);
+        const std::uint64_t folded = h ^ (h >> hash_bits);
+        if constexpr (hash_bits == sizeof(std::size_t) * 8) {
+            return static_cast<std::size_t>(folded);
+        }
+        else {
+            return static_cast<std::size_t>(folded & ((std::uint64_t(1) << hash_bits) - 1));
+        }
+    }
+
+}
+// namespace libsstring ends
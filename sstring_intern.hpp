@@ -0,0 +1,466 @@
+// sstring_intern.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <array>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <functional>
+#include <bit>
+
+#include "sstring.hpp"
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // Interned string record, a header followed by the null terminated chars
+    template<typename CharT>
+    struct basic_sstring_intern_entry {
+        std::size_t hash;                        // precomputed hash of the chars
+        std::size_t size;                        // length without the null terminator
+        std::atomic<std::size_t> pins;           // outstanding retain() calls, eviction keeps pinned entries
+
+        // @brief chars stored right behind the header
+        const CharT* data() const noexcept {
+            return reinterpret_cast<const CharT*>(this + 1);
+        }
+        CharT* data() noexcept {
+            return reinterpret_cast<CharT*>(this + 1);
+        }
+    };
+
+    // Interned string handle, equal strings from one pool share one entry and compare by pointer
+    template<
+        typename CharT = char,
+        typename Traits = std::char_traits<CharT>
+    >
+    class basic_sstring_interned {
+    // Public types
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using size_type = std::size_t;
+        using string_view_type = std::basic_string_view<CharT, Traits>;
+        using entry_type = basic_sstring_intern_entry<CharT>;
+
+    private:
+        const entry_type* entry_ = nullptr;
+
+        template<typename, typename, typename, std::size_t>
+        friend class basic_sstring_intern_pool;
+
+        // @brief only pools hand out non-null handles
+        explicit constexpr basic_sstring_interned(const entry_type* entry) noexcept : entry_(entry) {}
+
+    public:
+        // @brief construct a null handle, it views an empty string
+        constexpr basic_sstring_interned() noexcept = default;
+
+        // @brief true when the handle refers to an interned entry
+        constexpr bool valid() const noexcept {
+            return entry_ != nullptr;
+        }
+        constexpr explicit operator bool() const noexcept {
+            return valid();
+        }
+
+        // @brief precomputed hash, 0 for the null handle
+        constexpr size_type hash() const noexcept {
+            return entry_ ? entry_->hash : 0;
+        }
+
+        // @brief basic queries
+        constexpr size_type size() const noexcept {
+            return entry_ ? entry_->size : 0;
+        }
+        constexpr bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        // @brief null terminated chars, stable until the entry is evicted
+        const CharT* data() const noexcept {
+            static constexpr CharT empty_str[1] = {};
+            return entry_ ? entry_->data() : empty_str;
+        }
+        const CharT* c_str() const noexcept {
+            return data();
+        }
+
+        // @brief view the interned chars
+        string_view_type view() const noexcept {
+            return string_view_type(data(), size());
+        }
+        operator string_view_type() const noexcept {
+            return view();
+        }
+
+        // @brief identity comparison, O(1)
+        friend constexpr bool operator==(const basic_sstring_interned& a, const basic_sstring_interned& b) noexcept {
+            return a.entry_ == b.entry_;
+        }
+    };
+
+    // Thread-safe string intern pool, sharded by hash so lookups on different shards never contend
+    template<
+        typename CharT = char,
+        typename Traits = std::char_traits<CharT>,
+        typename Allocator = std::allocator<CharT>,
+        std::size_t ShardCount = 64
+    >
+    class basic_sstring_intern_pool {
+        static_assert(sizeof(CharT) == 1, "basic_sstring_intern_pool currently supports only byte-sized CharT, aka. char");
+        static_assert(ShardCount != 0 && (ShardCount & (ShardCount - 1)) == 0, "basic_sstring_intern_pool shard count must be a power of two");
+    // Public types
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using string_view_type = std::basic_string_view<CharT, Traits>;
+        using handle = basic_sstring_interned<CharT, Traits>;
+        using entry_type = basic_sstring_intern_entry<CharT>;
+
+    private:
+        // entries are carved from size_type words, header first and chars right after it
+        using word_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<size_type>;
+        using word_alloc_traits = std::allocator_traits<word_alloc_type>;
+
+        static constexpr size_type HEADER_WORDS = (sizeof(entry_type) + sizeof(size_type) - 1) / sizeof(size_type);
+        static constexpr size_type SHARD_BITS = static_cast<size_type>(std::bit_width(ShardCount) - 1);
+        static_assert(SHARD_BITS <= hash_bits, "basic_sstring_intern_pool has more shards than hash bits");
+        static constexpr size_type MIN_SLOTS = 16;
+
+        // one lock and one open addressing table per shard, kept on separate cache lines
+        struct alignas(64) shard {
+            mutable std::shared_mutex mutex;
+            std::vector<entry_type*> slots;      // linear probing, power of two, nullptr is empty
+            size_type count = 0;
+        };
+
+        word_alloc_type alloc_;
+        std::array<shard, ShardCount> shards_;
+
+        // @brief the sstring hash, so handles hash like the strings they intern
+        static size_type hash_of(string_view_type sv) noexcept {
+            return hash_string(sv.data(), sv.size());
+        }
+
+        // @brief shard from the top hash bits, the slot uses the low bits
+        static constexpr size_type shard_index(size_type h) noexcept {
+            if constexpr (ShardCount == 1) {
+                return 0;
+            }
+            else {
+                return h >> (hash_bits - SHARD_BITS);
+            }
+        }
+
+        // @brief words of an entry holding n chars and the null terminator
+        static constexpr size_type entry_words(size_type n) noexcept {
+            return HEADER_WORDS + (n + sizeof(size_type)) / sizeof(size_type);
+        }
+
+        // @brief allocate and fill an entry
+        entry_type* make_entry(string_view_type sv, size_type h) {
+            size_type* block = word_alloc_traits::allocate(alloc_, entry_words(sv.size()));
+            entry_type* e = ::new (static_cast<void*>(block)) entry_type{ h, sv.size(), 0 };
+            std::memcpy(e->data(), sv.data(), sv.size());
+            e->data()[sv.size()] = CharT();
+            return e;
+        }
+        void free_entry(entry_type* e) noexcept {
+            size_type words = entry_words(e->size);
+            e->~entry_type();
+            word_alloc_traits::deallocate(alloc_, reinterpret_cast<size_type*>(e), words);
+        }
+
+        // @brief find an entry, the shard lock must be held
+        static entry_type* probe(const shard& sh, string_view_type sv, size_type h) noexcept {
+            if (sh.slots.empty()) {
+                return nullptr;
+            }
+            const size_type mask = sh.slots.size() - 1;
+            for (size_type i = h & mask;; i = (i + 1) & mask) {
+                entry_type* e = sh.slots[i];
+                if (!e) {
+                    return nullptr;
+                }
+                if (e->hash == h && e->size == sv.size() && Traits::compare(e->data(), sv.data(), sv.size()) == 0) {
+                    return e;
+                }
+            }
+        }
+
+        // @brief place an entry into a table with a free slot
+        static void place(std::vector<entry_type*>& slots, entry_type* e) noexcept {
+            const size_type mask = slots.size() - 1;
+            size_type i = e->hash & mask;
+            while (slots[i]) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = e;
+        }
+
+        // @brief rebuild a shard table with room for count entries at under 3/4 load
+        static void rehash(shard& sh, size_type count) {
+            size_type want = MIN_SLOTS;
+            while (want * 3 < count * 4 + 4) {
+                want *= 2;
+            }
+            std::vector<entry_type*> slots(want, nullptr);
+            for (entry_type* e : sh.slots) {
+                if (e) {
+                    place(slots, e);
+                }
+            }
+            sh.slots.swap(slots);
+        }
+
+        // @brief find or insert under the exclusive shard lock
+        entry_type* find_or_insert_locked(shard& sh, string_view_type sv, size_type h) {
+            if (entry_type* e = probe(sh, sv, h)) {
+                return e;
+            }
+            if ((sh.count + 1) * 4 > sh.slots.size() * 3) {
+                rehash(sh, sh.count + 1);
+            }
+            entry_type* e = make_entry(sv, h);
+            place(sh.slots, e);
+            ++sh.count;
+            return e;
+        }
+
+    public:
+        // @brief construct an empty pool, entries are allocated through alloc
+        explicit basic_sstring_intern_pool(const Allocator& alloc = Allocator()) : alloc_(alloc) {}
+
+        basic_sstring_intern_pool(const basic_sstring_intern_pool&) = delete;
+        basic_sstring_intern_pool& operator=(const basic_sstring_intern_pool&) = delete;
+
+        // @brief free every entry, outstanding handles dangle afterwards
+        ~basic_sstring_intern_pool() {
+            for (shard& sh : shards_) {
+                for (entry_type* e : sh.slots) {
+                    if (e) {
+                        free_entry(e);
+                    }
+                }
+            }
+        }
+
+        // @brief intern a string, hits only take the shared shard lock
+        handle intern(string_view_type sv) {
+            const size_type h = hash_of(sv);
+            shard& sh = shards_[shard_index(h)];
+            {
+                std::shared_lock<std::shared_mutex> lock(sh.mutex);
+                if (const entry_type* e = probe(sh, sv, h)) {
+                    return handle(e);
+                }
+            }
+            std::unique_lock<std::shared_mutex> lock(sh.mutex);
+            return handle(find_or_insert_locked(sh, sv, h));
+        }
+
+        // @brief intern a range of strings into out, each touched shard is locked once per pass
+        // elements are only viewed when they stay alive as lvalues of a forward range, otherwise they are copied first
+        template<std::input_iterator InputIt, typename OutputIt>
+        OutputIt intern(InputIt first, InputIt last, OutputIt out) {
+            std::vector<string_view_type> views;
+            std::vector<std::basic_string<CharT, Traits>> owned;
+            if constexpr (std::forward_iterator<InputIt> && std::is_lvalue_reference_v<std::iter_reference_t<InputIt>>) {
+                for (; first != last; ++first) {
+                    views.emplace_back(string_view_type(*first));
+                }
+            }
+            else {
+                for (; first != last; ++first) {
+                    owned.emplace_back(string_view_type(*first));
+                }
+                views.assign(owned.begin(), owned.end());
+            }
+            const size_type n = views.size();
+            std::vector<size_type> hashes(n);
+            std::vector<const entry_type*> found(n, nullptr);
+
+            // bucket the inputs by shard with a counting sort
+            std::vector<size_type> starts(ShardCount + 1, 0);
+            std::vector<size_type> order(n);
+            for (size_type i = 0; i < n; ++i) {
+                hashes[i] = hash_of(views[i]);
+                ++starts[shard_index(hashes[i]) + 1];
+            }
+            for (size_type s = 0; s < ShardCount; ++s) {
+                starts[s + 1] += starts[s];
+            }
+            {
+                std::vector<size_type> fill(starts.begin(), starts.end() - 1);
+                for (size_type i = 0; i < n; ++i) {
+                    order[fill[shard_index(hashes[i])]++] = i;
+                }
+            }
+
+            for (size_type s = 0; s < ShardCount; ++s) {
+                if (starts[s] == starts[s + 1]) {
+                    continue;
+                }
+                shard& sh = shards_[s];
+                bool missed = false;
+                {
+                    std::shared_lock<std::shared_mutex> lock(sh.mutex);
+                    for (size_type k = starts[s]; k < starts[s + 1]; ++k) {
+                        const size_type i = order[k];
+                        found[i] = probe(sh, views[i], hashes[i]);
+                        missed |= found[i] == nullptr;
+                    }
+                }
+                if (missed) {
+                    std::unique_lock<std::shared_mutex> lock(sh.mutex);
+                    for (size_type k = starts[s]; k < starts[s + 1]; ++k) {
+                        const size_type i = order[k];
+                        if (!found[i]) {
+                            found[i] = find_or_insert_locked(sh, views[i], hashes[i]);
+                        }
+                    }
+                }
+            }
+
+            for (size_type i = 0; i < n; ++i) {
+                *out = handle(found[i]);
+                ++out;
+            }
+            return out;
+        }
+
+        // @brief look up without inserting, a null handle when absent
+        handle find(string_view_type sv) const {
+            const size_type h = hash_of(sv);
+            const shard& sh = shards_[shard_index(h)];
+            std::shared_lock<std::shared_mutex> lock(sh.mutex);
+            return handle(probe(sh, sv, h));
+        }
+
+        // @brief pin an entry so evict_unused keeps it
+        void retain(handle h) noexcept {
+            if (h.entry_) {
+                const_cast<entry_type*>(h.entry_)->pins.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // @brief drop a pin taken by retain
+        void release(handle h) noexcept {
+            if (h.entry_) {
+                const_cast<entry_type*>(h.entry_)->pins.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        // @brief free every unpinned entry and return how many were freed
+        // only safe when every handle still in use has been retained
+        size_type evict_unused() {
+            size_type freed = 0;
+            for (shard& sh : shards_) {
+                std::unique_lock<std::shared_mutex> lock(sh.mutex);
+                if (sh.count == 0) {
+                    continue;
+                }
+                std::vector<entry_type*> kept;
+                kept.reserve(sh.count);
+                for (entry_type* e : sh.slots) {
+                    if (!e) {
+                        continue;
+                    }
+                    if (e->pins.load(std::memory_order_acquire) == 0) {
+                        free_entry(e);
+                        ++freed;
+                    }
+                    else {
+                        kept.push_back(e);
+                    }
+                }
+                sh.slots.clear();
+                sh.count = kept.size();
+                if (!kept.empty()) {
+                    sh.slots.swap(kept);
+                    rehash(sh, sh.count);
+                }
+            }
+            return freed;
+        }
+
+        // @brief number of distinct interned strings
+        size_type size() const {
+            size_type total = 0;
+            for (const shard& sh : shards_) {
+                std::shared_lock<std::shared_mutex> lock(sh.mutex);
+                total += sh.count;
+            }
+            return total;
+        }
+
+        // @brief get the entry allocator
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(alloc_);
+        }
+    };
+
+    // convenience alias for char interned handle
+    using sstring_interned = basic_sstring_interned<char, std::char_traits<char>>;
+
+    // convenience alias for char intern pool
+    using sstring_intern_pool = basic_sstring_intern_pool<char, std::char_traits<char>>;
+
+}
+// namespace libsstring ends
+
+// namespace std starts
+namespace std {
+
+    // hash specialization for interned handles, reuses the stored hash
+    template<class CharT, class Traits>
+    struct hash<libsstring::basic_sstring_interned<CharT, Traits>> {
+        size_t operator()(const libsstring::basic_sstring_interned<CharT, Traits>& h) const noexcept {
+            return h.hash();
+        }
+    };
+
+}
+// namespace std ends
@@ -0,0 +1,334 @@
+// sstring_pool.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <type_traits>
+
+#include "sstring.hpp"
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // size classes served from per-thread free lists, larger requests go straight to operator new
+    inline constexpr std::size_t pool_class_sizes[] = {
+        32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096
+    };
+    inline constexpr std::size_t pool_class_count = std::size(pool_class_sizes);
+    inline constexpr std::size_t pool_max_bytes = 4096;
+
+    // slabs are carved into blocks of one class, aligned to their size so a block finds its slab by masking
+    inline constexpr std::size_t pool_slab_bytes = std::size_t(64) << 10;
+    inline constexpr std::size_t pool_block_align = 16;
+
+    // slow path events reported to the optional hook
+    enum class pool_event : unsigned char {
+        slab_acquired,                           // a thread cache carved a new slab
+        large_allocate,                          // a request above pool_max_bytes went to operator new
+        large_deallocate,                        // and came back
+        cache_created,                           // a new thread cache was registered
+        cache_adopted,                           // a thread reused the cache of an exited thread
+    };
+    using pool_event_hook = void (*)(pool_event event, std::size_t bytes) noexcept;
+
+    // snapshot of the pool counters summed over every thread cache
+    struct pool_stats {
+        std::size_t allocations = 0;             // pooled allocations
+        std::size_t deallocations = 0;           // pooled deallocations, remote ones included
+        std::size_t remote_deallocations = 0;    // blocks returned to another thread's cache
+        std::size_t large_allocations = 0;       // requests served by operator new
+        std::size_t slabs = 0;                   // slabs carved, never returned
+        std::size_t threads = 0;                 // caches owned by a live thread
+    };
+
+    // free block, the link lives in the block itself
+    struct pool_free_node {
+        pool_free_node* next;
+    };
+
+    struct pool_thread_cache;
+
+    // slab header, the first block starts on the next cache line
+    struct alignas(64) pool_slab {
+        pool_thread_cache* owner;                // cache that carved the slab and receives its frees
+        std::size_t cls;                         // size class of every block in the slab
+    };
+
+    // per-thread cache, caches are never destroyed: an exited thread's cache is adopted by the next new thread
+    struct alignas(64) pool_thread_cache {
+        pool_free_node* local[pool_class_count] = {};              // owner only
+        std::atomic<std::size_t> allocations{ 0 };                 // owner writes, relaxed
+        std::atomic<std::size_t> deallocations{ 0 };               // local frees only
+        std::atomic<std::size_t> large_allocations{ 0 };
+        std::atomic<std::size_t> slabs{ 0 };
+        std::atomic<bool> orphaned{ false };                       // owning thread exited
+        pool_thread_cache* next_registered = nullptr;              // registry link, immutable once published
+        alignas(64) std::atomic<pool_free_node*> remote{ nullptr };  // lock-free stack other threads free into
+        std::atomic<std::size_t> remote_received{ 0 };             // blocks pushed onto remote, any thread
+    };
+
+    // every cache ever created
+    inline std::atomic<pool_thread_cache*> pool_registry{ nullptr };
+
+    // optional slow path hook
+    inline std::atomic<pool_event_hook> pool_hook{ nullptr };
+
+    // @brief install a hook for slow path events, nullptr removes it
+    inline void set_pool_event_hook(pool_event_hook hook) noexcept {
+        pool_hook.store(hook, std::memory_order_release);
+    }
+
+    // @brief report a slow path event
+    inline void pool_notify(pool_event event, std::size_t bytes) noexcept {
+        if (pool_event_hook hook = pool_hook.load(std::memory_order_acquire)) {
+            hook(event, bytes);
+        }
+    }
+
+    // @brief owner-only relaxed counter bump, no read-modify-write needed
+    inline void pool_count(std::atomic<std::size_t>& counter) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // size class of a request in 16 byte steps
+    inline constexpr auto pool_class_table = [] {
+        std::array<unsigned char, pool_max_bytes / 16 + 1> table{};
+        std::size_t cls = 0;
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            while (pool_class_sizes[cls] < i * 16) {
+                ++cls;
+            }
+            table[i] = static_cast<unsigned char>(cls);
+        }
+        return table;
+    }();
+
+    // @brief size class for bytes, bytes must not exceed pool_max_bytes
+    inline std::size_t pool_class_of(std::size_t bytes) noexcept {
+        return pool_class_table[(bytes + 15) >> 4];
+    }
+
+    // @brief slab owning a pooled block
+    inline pool_slab* pool_slab_of(void* p) noexcept {
+        return reinterpret_cast<pool_slab*>(reinterpret_cast<std::uintptr_t>(p) & ~(std::uintptr_t(pool_slab_bytes) - 1));
+    }
+
+    // @brief adopt an exited thread's cache or register a new one
+    inline pool_thread_cache* pool_acquire_cache() {
+        for (pool_thread_cache* c = pool_registry.load(std::memory_order_acquire); c; c = c->next_registered) {
+            bool expected = true;
+            if (c->orphaned.load(std::memory_order_relaxed) &&
+                c->orphaned.compare_exchange_strong(expected, false, std::memory_order_acq_rel)) {
+                pool_notify(pool_event::cache_adopted, 0);
+                return c;
+            }
+        }
+        pool_thread_cache* c = new pool_thread_cache();
+        c->next_registered = pool_registry.load(std::memory_order_relaxed);
+        while (!pool_registry.compare_exchange_weak(c->next_registered, c, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        pool_notify(pool_event::cache_created, sizeof(pool_thread_cache));
+        return c;
+    }
+
+    // thread's cache slot, the cache is orphaned for adoption when the thread exits
+    struct pool_cache_holder {
+        pool_thread_cache* cache = nullptr;
+        ~pool_cache_holder() {
+            if (cache) {
+                cache->orphaned.store(true, std::memory_order_release);
+                cache = nullptr;
+            }
+        }
+    };
+    inline thread_local pool_cache_holder pool_tls;
+
+    // @brief this thread's cache, created on first use
+    inline pool_thread_cache& pool_local_cache() {
+        if (!pool_tls.cache) [[unlikely]] {
+            pool_tls.cache = pool_acquire_cache();
+        }
+        return *pool_tls.cache;
+    }
+
+    // @brief move every block freed by other threads into the local lists
+    inline void pool_drain_remote(pool_thread_cache& c) noexcept {
+        pool_free_node* n = c.remote.exchange(nullptr, std::memory_order_acquire);
+        while (n) {
+            pool_free_node* next = n->next;
+            const std::size_t cls = pool_slab_of(n)->cls;
+            n->next = c.local[cls];
+            c.local[cls] = n;
+            n = next;
+        }
+    }
+
+    // @brief carve a new slab for one class into the local list
+    inline void pool_refill(pool_thread_cache& c, std::size_t cls) {
+        void* mem = ::operator new(pool_slab_bytes, std::align_val_t(pool_slab_bytes));
+        pool_slab* slab = ::new (mem) pool_slab{ &c, cls };
+        const std::size_t size = pool_class_sizes[cls];
+        unsigned char* first = static_cast<unsigned char*>(mem) + sizeof(pool_slab);
+        const std::size_t count = (pool_slab_bytes - sizeof(pool_slab)) / size;
+        // link back to front so blocks are handed out in address order
+        pool_free_node* head = c.local[cls];
+        for (std::size_t i = count; i-- > 0;) {
+            pool_free_node* n = reinterpret_cast<pool_free_node*>(first + i * size);
+            n->next = head;
+            head = n;
+        }
+        c.local[cls] = head;
+        (void)slab;
+        pool_count(c.slabs);
+        pool_notify(pool_event::slab_acquired, pool_slab_bytes);
+    }
+
+    // @brief allocate bytes, small requests pop the thread's free list
+    inline void* pool_allocate(std::size_t bytes) {
+        if (bytes > pool_max_bytes) [[unlikely]] {
+            pool_thread_cache& c = pool_local_cache();
+            pool_count(c.large_allocations);
+            pool_notify(pool_event::large_allocate, bytes);
+            return ::operator new(bytes);
+        }
+        pool_thread_cache& c = pool_local_cache();
+        const std::size_t cls = pool_class_of(bytes);
+        pool_free_node* n = c.local[cls];
+        if (!n) [[unlikely]] {
+            pool_drain_remote(c);
+            n = c.local[cls];
+            if (!n) {
+                pool_refill(c, cls);
+                n = c.local[cls];
+            }
+        }
+        c.local[cls] = n->next;
+        pool_count(c.allocations);
+        return n;
+    }
+
+    // @brief free bytes allocated by pool_allocate, blocks owned by another thread go to its remote stack
+    inline void pool_deallocate(void* p, std::size_t bytes) noexcept {
+        if (!p) {
+            return;
+        }
+        if (bytes > pool_max_bytes) [[unlikely]] {
+            ::operator delete(p);
+            pool_notify(pool_event::large_deallocate, bytes);
+            return;
+        }
+        pool_slab* slab = pool_slab_of(p);
+        pool_free_node* n = static_cast<pool_free_node*>(p);
+        pool_thread_cache* c = pool_tls.cache;
+        if (slab->owner == c) [[likely]] {
+            n->next = c->local[slab->cls];
+            c->local[slab->cls] = n;
+            pool_count(c->deallocations);
+            return;
+        }
+        std::atomic<pool_free_node*>& remote = slab->owner->remote;
+        n->next = remote.load(std::memory_order_relaxed);
+        while (!remote.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        slab->owner->remote_received.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // @brief usable bytes of a pooled request
+    inline constexpr std::size_t pool_usable_bytes(std::size_t bytes) noexcept {
+        return bytes > pool_max_bytes ? bytes : pool_class_sizes[pool_class_table[(bytes + 15) >> 4]];
+    }
+
+    // @brief sum the counters of every cache, counters of running threads are read relaxed
+    inline pool_stats pool_statistics() noexcept {
+        pool_stats s;
+        for (pool_thread_cache* c = pool_registry.load(std::memory_order_acquire); c; c = c->next_registered) {
+            s.allocations += c->allocations.load(std::memory_order_relaxed);
+            const std::size_t remote = c->remote_received.load(std::memory_order_relaxed);
+            s.deallocations += c->deallocations.load(std::memory_order_relaxed) + remote;
+            s.remote_deallocations += remote;
+            s.large_allocations += c->large_allocations.load(std::memory_order_relaxed);
+            s.slabs += c->slabs.load(std::memory_order_relaxed);
+            s.threads += c->orphaned.load(std::memory_order_relaxed) ? 0 : 1;
+        }
+        return s;
+    }
+
+    // result of pool_allocator::allocate_at_least
+    template<typename T>
+    struct pool_allocation {
+        T* ptr;
+        std::size_t count;
+    };
+
+    // Stateless allocator over the thread-local size class pool
+    template<typename T>
+    class pool_allocator {
+        static_assert(alignof(T) <= pool_block_align, "pool_allocator blocks are only 16 byte aligned");
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using is_always_equal = std::true_type;
+
+        constexpr pool_allocator() noexcept = default;
+        template<typename U>
+        constexpr pool_allocator(const pool_allocator<U>&) noexcept {}
+
+        // @brief allocate n elements
+        T* allocate(size_type n) {
+            return static_cast<T*>(pool_allocate(n * sizeof(T)));
+        }
+
+        // @brief allocate at least n elements, the whole size class is reported back
+        pool_allocation<T> allocate_at_least(size_type n) {
+            const size_type bytes = pool_usable_bytes(n * sizeof(T));
+            return { static_cast<T*>(pool_allocate(bytes)), bytes / sizeof(T) };
+        }
+
+        // @brief return n elements to the pool
+        void deallocate(T* p, size_type n) noexcept {
+            pool_deallocate(p, n * sizeof(T));
+        }
+
+        friend constexpr bool operator==(const pool_allocator&, const pool_allocator&) noexcept {
+            return true;
+        }
+    };
+
+    // convenience alias for char basic sstring over the pool allocator
+    using sstring_pooled = basic_sstring<char, std::char_traits<char>, pool_allocator<char>, std::uint8_t, 30, 16>;
+
+}
+// namespace libsstring ends
@@ -0,0 +1,818 @@
+// sstring_search.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+#include <ranges>
+#include <bit>
+
+#include "sstring_simd.hpp"
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // Two-Way critical factorization of a needle (Crochemore-Perrin)
+    struct two_way_plan {
+        std::size_t suffix = 0;                  // start of the right half
+        std::size_t period = 1;                  // period of the needle when periodic
+        bool periodic = false;                   // needle[0, suffix) repeats at needle + period
+
+        // @brief compute the critical factorization in O(m) time and O(1) space
+        static two_way_plan make(const unsigned char* needle, std::size_t m) noexcept {
+            two_way_plan plan;
+            if (m < 3) {
+                plan.suffix = m ? m - 1 : 0;
+                plan.period = 1;
+                plan.periodic = m == 2 ? needle[0] == needle[1] : m == 1;
+                return plan;
+            }
+
+            // maximal suffix for the natural order
+            std::size_t max_suffix = static_cast<std::size_t>(-1);
+            std::size_t j = 0, k = 1, p = 1;
+            while (j + k < m) {
+                const unsigned char a = needle[j + k];
+                const unsigned char b = needle[max_suffix + k];
+                if (a < b) {
+                    j += k;
+                    k = 1;
+                    p = j - max_suffix;
+                }
+                else if (a == b) {
+                    if (k != p) {
+                        ++k;
+                    }
+                    else {
+                        j += p;
+                        k = 1;
+                    }
+                }
+                else {
+                    max_suffix = j++;
+                    k = p = 1;
+                }
+            }
+            const std::size_t period = p;
+
+            // maximal suffix for the reversed order
+            std::size_t max_suffix_rev = static_cast<std::size_t>(-1);
+            j = 0;
+            k = p = 1;
+            while (j + k < m) {
+                const unsigned char a = needle[j + k];
+                const unsigned char b = needle[max_suffix_rev + k];
+                if (b < a) {
+                    j += k;
+                    k = 1;
+                    p = j - max_suffix_rev;
+                }
+                else if (a == b) {
+                    if (k != p) {
+                        ++k;
+                    }
+                    else {
+                        j += p;
+                        k = 1;
+                    }
+                }
+                else {
+                    max_suffix_rev = j++;
+                    k = p = 1;
+                }
+            }
+
+            // the later of the two suffixes is the critical position
+            if (max_suffix_rev + 1 < max_suffix + 1) {
+                plan.suffix = max_suffix + 1;
+                plan.period = period;
+            }
+            else {
+                plan.suffix = max_suffix_rev + 1;
+                plan.period = p;
+            }
+            plan.periodic = plan.suffix + plan.period <= m
+                && std::memcmp(needle, needle + plan.period, plan.suffix) == 0;
+            return plan;
+        }
+    };
+
+    // @brief advance j to the next alignment whose hay[j + suffix] equals needle[suffix], false if none is left
+    inline bool two_way_skip(const unsigned char* hay, std::size_t last, const unsigned char* needle,
+                             std::size_t suffix, std::size_t& j) noexcept {
+        if (hay[j + suffix] == needle[suffix]) {
+            return true;
+        }
+        // every match needs this byte, so skipping to it never misses one
+        const void* p = simd::memchr(hay + j + suffix, needle[suffix], last - j + 1);
+        if (!p) {
+            return false;
+        }
+        j = static_cast<std::size_t>(static_cast<const unsigned char*>(p) - hay) - suffix;
+        return true;
+    }
+
+    // @brief Two-Way search without a shift table, linear time and constant space
+    inline const unsigned char* two_way_find(const unsigned char* hay, std::size_t n,
+                                             const unsigned char* needle, std::size_t m,
+                                             const two_way_plan& plan) noexcept {
+        if (m == 0 || m > n) {
+            return nullptr;
+        }
+        const std::size_t suffix = plan.suffix;
+        const std::size_t last = n - m;
+        std::size_t j = 0;
+        if (plan.periodic) {
+            const std::size_t period = plan.period;
+            std::size_t memory = 0;
+            while (j <= last) {
+                if (memory == 0 && !two_way_skip(hay, last, needle, suffix, j)) {
+                    return nullptr;
+                }
+                std::size_t i = std::max(suffix, memory);
+                while (i < m && needle[i] == hay[i + j]) {
+                    ++i;
+                }
+                if (i >= m) {
+                    i = suffix - 1;
+                    while (memory < i + 1 && needle[i] == hay[i + j]) {
+                        --i;
+                    }
+                    if (i + 1 < memory + 1) {
+                        return hay + j;
+                    }
+                    j += period;
+                    memory = m - period;
+                }
+                else {
+                    j += i - suffix + 1;
+                    memory = 0;
+                }
+            }
+        }
+        else {
+            const std::size_t period = std::max(suffix, m - suffix) + 1;
+            while (j <= last) {
+                if (!two_way_skip(hay, last, needle, suffix, j)) {
+                    return nullptr;
+                }
+                std::size_t i = suffix + 1;
+                while (i < m && needle[i] == hay[i + j]) {
+                    ++i;
+                }
+                if (i >= m) {
+                    i = suffix - 1;
+                    while (i != static_cast<std::size_t>(-1) && needle[i] == hay[i + j]) {
+                        --i;
+                    }
+                    if (i == static_cast<std::size_t>(-1)) {
+                        return hay + j;
+                    }
+                    j += period;
+                }
+                else {
+                    j += i - suffix + 1;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief Two-Way search with a bad-character table on the window's last byte, still linear
+    inline const unsigned char* two_way_find(const unsigned char* hay, std::size_t n,
+                                             const unsigned char* needle, std::size_t m,
+                                             const two_way_plan& plan, const std::size_t* shift) noexcept {
+        if (m == 0 || m > n) {
+            return nullptr;
+        }
+        const std::size_t suffix = plan.suffix;
+        const std::size_t last = n - m;
+        std::size_t j = 0;
+        if (plan.periodic) {
+            const std::size_t period = plan.period;
+            std::size_t memory = 0;
+            while (j <= last) {
+                if (memory == 0 && !two_way_skip(hay, last, needle, suffix, j)) {
+                    return nullptr;
+                }
+                std::size_t s = shift[hay[j + m - 1]];
+                if (s != 0) {
+                    // a periodic needle with its last period out of place cannot match before the mismatch
+                    if (memory && s < period) {
+                        s = m - period;
+                    }
+                    memory = 0;
+                    j += s;
+                    continue;
+                }
+                std::size_t i = std::max(suffix, memory);
+                while (i < m - 1 && needle[i] == hay[i + j]) {
+                    ++i;
+                }
+                if (i >= m - 1) {
+                    i = suffix - 1;
+                    while (memory < i + 1 && needle[i] == hay[i + j]) {
+                        --i;
+                    }
+                    if (i + 1 < memory + 1) {
+                        return hay + j;
+                    }
+                    j += period;
+                    memory = m - period;
+                }
+                else {
+                    j += i - suffix + 1;
+                    memory = 0;
+                }
+            }
+        }
+        else {
+            const std::size_t period = std::max(suffix, m - suffix) + 1;
+            while (j <= last) {
+                if (!two_way_skip(hay, last, needle, suffix, j)) {
+                    return nullptr;
+                }
+                const std::size_t s = shift[hay[j + m - 1]];
+                if (s != 0) {
+                    j += s;
+                    continue;
+                }
+                std::size_t i = suffix;
+                while (i < m - 1 && needle[i] == hay[i + j]) {
+                    ++i;
+                }
+                if (i >= m - 1) {
+                    i = suffix - 1;
+                    while (i != static_cast<std::size_t>(-1) && needle[i] == hay[i + j]) {
+                        --i;
+                    }
+                    if (i == static_cast<std::size_t>(-1)) {
+                        return hay + j;
+                    }
+                    j += period;
+                }
+                else {
+                    j += i - suffix + 1;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // needles up to this length use the simd first+last byte filter
+    inline constexpr std::size_t short_needle_length = 32;
+
+    // @brief one-shot substring search, the kernel is picked by needle length, 1 <= m <= n
+    inline const void* find_bytes(const void* hay, std::size_t n, const void* needle, std::size_t m) noexcept {
+        const unsigned char* nd = static_cast<const unsigned char*>(needle);
+        // single and double characters
+        if (m == 1) {
+            return simd::memchr(hay, nd[0], n);
+        }
+        if (m == 2) {
+            return simd::find_pair(hay, nd[0], nd[1], n);
+        }
+        // short needles, simd first+last byte filter
+        if (m <= short_needle_length) {
+            return simd::find_substr(hay, n, needle, m);
+        }
+        // long needles, Two-Way keeps the worst case linear without building a table
+        return two_way_find(static_cast<const unsigned char*>(hay), n, nd, m, two_way_plan::make(nd, m));
+    }
+
+    // Precomputed character class, a 256-bit table plus nibble-shuffle tables for the simd scans
+    template<
+        typename CharT = char,
+        typename Traits = std::char_traits<CharT>
+    >
+    class basic_sstring_charset {
+        static_assert(sizeof(CharT) == 1, "basic_sstring_charset currently supports only byte-sized CharT, aka. char");
+    // Public types
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using size_type = std::size_t;
+        using string_view_type = std::basic_string_view<CharT, Traits>;
+
+    private:
+        simd::byte_set set_;
+
+    public:
+        // @brief construct an empty set
+        constexpr basic_sstring_charset() noexcept = default;
+
+        // @brief construct from the characters of a string
+        explicit constexpr basic_sstring_charset(string_view_type chars) noexcept {
+            add(chars);
+        }
+
+        // @brief construct from a C-string
+        explicit constexpr basic_sstring_charset(const CharT* chars) noexcept {
+            add(string_view_type(chars));
+        }
+
+        // @brief construct from a predicate evaluated on every byte value
+        template <typename Pred>
+        static constexpr basic_sstring_charset from_predicate(Pred pred) {
+            basic_sstring_charset r;
+            for (unsigned c = 0; c < 256; ++c) {
+                if (pred(static_cast<CharT>(c))) {
+                    r.set_.add(static_cast<unsigned char>(c));
+                }
+            }
+            return r;
+        }
+
+    public:
+        // @brief add a character
+        constexpr basic_sstring_charset& add(CharT ch) noexcept {
+            set_.add(static_cast<unsigned char>(ch));
+            return *this;
+        }
+
+        // @brief add every character of a string
+        constexpr basic_sstring_charset& add(string_view_type chars) noexcept {
+            for (CharT ch : chars) {
+                set_.add(static_cast<unsigned char>(ch));
+            }
+            return *this;
+        }
+
+        // @brief add an inclusive range of characters, compared as unsigned bytes
+        constexpr basic_sstring_charset& add_range(CharT first, CharT last) noexcept {
+            for (unsigned c = static_cast<unsigned char>(first); c <= static_cast<unsigned char>(last); ++c) {
+                set_.add(static_cast<unsigned char>(c));
+            }
+            return *this;
+        }
+
+        // @brief test a character
+        constexpr bool contains(CharT ch) const noexcept {
+            return set_.contains(static_cast<unsigned char>(ch));
+        }
+
+        // @brief union of two sets
+        constexpr friend basic_sstring_charset operator|(const basic_sstring_charset& a, const basic_sstring_charset& b) noexcept {
+            basic_sstring_charset r;
+            for (unsigned c = 0; c < 256; ++c) {
+                if (a.set_.contains(static_cast<unsigned char>(c)) || b.set_.contains(static_cast<unsigned char>(c))) {
+                    r.set_.add(static_cast<unsigned char>(c));
+                }
+            }
+            return r;
+        }
+
+        // @brief complement of a set
+        constexpr basic_sstring_charset operator~() const noexcept {
+            basic_sstring_charset r;
+            for (unsigned c = 0; c < 256; ++c) {
+                if (!set_.contains(static_cast<unsigned char>(c))) {
+                    r.set_.add(static_cast<unsigned char>(c));
+                }
+            }
+            return r;
+        }
+
+    public:
+        // @brief the underlying byte set, for the simd kernels
+        constexpr const simd::byte_set& bytes() const noexcept {
+            return set_;
+        }
+
+        // @brief first character in [p, p + n) that is (member) or is not (!member) in the set, nullptr if none
+        const CharT* scan(const CharT* p, size_type n, bool member = true) const noexcept {
+            return static_cast<const CharT*>(simd::find_in_set(p, n, set_, member));
+        }
+
+        // @brief last character in [p, p + n) that is (member) or is not (!member) in the set, nullptr if none
+        const CharT* rscan(const CharT* p, size_type n, bool member = true) const noexcept {
+            return static_cast<const CharT*>(simd::rfind_in_set(p, n, set_, member));
+        }
+    };
+
+    // convenience alias for char charset
+    using sstring_charset = basic_sstring_charset<char, std::char_traits<char>>;
+
+    // Precompiled substring searcher, build once from a needle and reuse across haystacks
+    template<
+        typename CharT = char,
+        typename Traits = std::char_traits<CharT>
+    >
+    class basic_sstring_searcher {
+        static_assert(sizeof(CharT) == 1, "basic_sstring_searcher currently supports only byte-sized CharT, aka. char");
+    // Public types
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using size_type = std::size_t;
+        using string_view_type = std::basic_string_view<CharT, Traits>;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // needles up to this length use the simd first+last byte filter
+        static constexpr size_type short_needle = short_needle_length;
+
+        // algorithm chosen at construction
+        enum class algorithm : unsigned char {
+            empty,                               // empty needle, never matches
+            single,                              // 1 byte, simd memchr
+            pair,                                // 2 bytes, simd adjacent pair search
+            filter,                              // up to short_needle bytes, simd first+last byte filter
+            two_way,                             // longer, Two-Way with a bad-character table
+        };
+
+    private:
+        std::basic_string<CharT, Traits> needle_;
+        algorithm algo_ = algorithm::empty;
+        two_way_plan plan_;
+        std::vector<size_type> shift_;           // 256 entries, two_way only
+
+        // @brief needle as unsigned bytes
+        const unsigned char* needle_bytes() const noexcept {
+            return reinterpret_cast<const unsigned char*>(needle_.data());
+        }
+
+    public:
+        // @brief construct an empty searcher that never matches
+        basic_sstring_searcher() = default;
+
+        // @brief construct a searcher from a needle, O(m) preprocessing
+        explicit basic_sstring_searcher(string_view_type needle) : needle_(needle) {
+            const size_type m = needle_.size();
+            if (m == 0) {
+                algo_ = algorithm::empty;
+            }
+            else if (m == 1) {
+                algo_ = algorithm::single;
+            }
+            else if (m == 2) {
+                algo_ = algorithm::pair;
+            }
+            else if (m <= short_needle) {
+                algo_ = algorithm::filter;
+            }
+            else {
+                algo_ = algorithm::two_way;
+                const unsigned char* nd = needle_bytes();
+                plan_ = two_way_plan::make(nd, m);
+                shift_.assign(256, m);
+                for (size_type i = 0; i < m; ++i) {
+                    shift_[nd[i]] = m - i - 1;
+                }
+            }
+        }
+
+    public:
+        // @brief the needle
+        string_view_type needle() const noexcept {
+            return string_view_type(needle_.data(), needle_.size());
+        }
+
+        // @brief needle length
+        size_type size() const noexcept {
+            return needle_.size();
+        }
+
+        // @brief the algorithm selected for this needle
+        algorithm selected() const noexcept {
+            return algo_;
+        }
+
+        // @brief search a raw range, returns the match or nullptr
+        const CharT* search(const CharT* hay, size_type n) const noexcept {
+            const size_type m = needle_.size();
+            if (m == 0 || m > n) {
+                return nullptr;
+            }
+            const void* p = nullptr;
+            switch (algo_) {
+            case algorithm::single:
+                p = simd::memchr(hay, static_cast<unsigned char>(needle_[0]), n);
+                break;
+            case algorithm::pair:
+                p = simd::find_pair(hay, static_cast<unsigned char>(needle_[0]), static_cast<unsigned char>(needle_[1]), n);
+                break;
+            case algorithm::filter:
+                p = simd::find_substr(hay, n, needle_.data(), m);
+                break;
+            case algorithm::two_way:
+                p = two_way_find(reinterpret_cast<const unsigned char*>(hay), n, needle_bytes(), m, plan_, shift_.data());
+                break;
+            default:
+                break;
+            }
+            return static_cast<const CharT*>(p);
+        }
+
+        // @brief find the needle in a haystack from a position, returns npos if not found
+        size_type find_in(string_view_type hay, size_type pos = 0) const noexcept {
+            if (pos > hay.size()) [[unlikely]] {
+                return npos;
+            }
+            const CharT* p = search(hay.data() + pos, hay.size() - pos);
+            return p ? static_cast<size_type>(p - hay.data()) : npos;
+        }
+
+        // @brief std::search compatible call over contiguous ranges, returns [match, match + m) or [last, last)
+        template <std::contiguous_iterator It>
+        std::pair<It, It> operator()(It first, It last) const noexcept {
+            const CharT* base = std::to_address(first);
+            const CharT* p = search(base, static_cast<size_type>(last - first));
+            if (!p) {
+                return { last, last };
+            }
+            const It match = first + (p - base);
+            return { match, match + static_cast<std::ptrdiff_t>(needle_.size()) };
+        }
+    };
+
+    // convenience alias for char searcher
+    using sstring_searcher = basic_sstring_searcher<char, std::char_traits<char>>;
+
+    // Cursor of a block scan, one simd mask hands out every delimiter of up to 64 bytes
+    struct split_block {
+        std::size_t base = 0;                    // position of mask bit 0
+        std::size_t next = 0;                    // first position no mask has covered yet
+        std::uint64_t mask = 0;                  // hits of the current block not handed out yet
+    };
+
+    // @brief next hit of a block scan, mask_of(p, n) answers one block, seek(p, n) runs ahead over sparse stretches
+    template <typename MaskFn, typename SeekFn>
+    inline std::size_t split_block_next(const unsigned char* s, std::size_t n, split_block& b, MaskFn mask_of, SeekFn seek) noexcept {
+        for (;;) {
+            if (b.mask) {
+                const std::size_t pos = b.base + static_cast<std::size_t>(std::countr_zero(b.mask));
+                b.mask &= b.mask - 1;
+                return pos;
+            }
+            if (b.next >= n) {
+                return static_cast<std::size_t>(-1);
+            }
+            std::size_t at = b.next;
+            std::uint64_t m = mask_of(s + at, n - at);
+            if (!m) {
+                // no hit in a whole block, let the long scan kernel find the next one
+                at += 64;
+                const void* hit = at < n ? seek(s + at, n - at) : nullptr;
+                if (!hit) {
+                    b.next = n;
+                    return static_cast<std::size_t>(-1);
+                }
+                at = static_cast<std::size_t>(static_cast<const unsigned char*>(hit) - s);
+                m = mask_of(s + at, n - at);
+            }
+            b.base = at;
+            b.mask = m;
+            b.next = at + std::min<std::size_t>(64, n - at);
+        }
+    }
+
+    // Split delimiter, a single character
+    template<
+        typename CharT = char,
+        typename Traits = std::char_traits<CharT>
+    >
+    class split_on_char {
+        CharT ch_;
+
+    public:
+        using size_type = std::size_t;
+
+        explicit constexpr split_on_char(CharT ch) noexcept : ch_(ch) {}
+
+        // @brief delimiter length
+        constexpr size_type width() const noexcept {
+            return 1;
+        }
+
+        // @brief next delimiter in [from, n), the block cursor already stands at from
+        size_type next(const CharT* s, size_type n, size_type, split_block& b) const noexcept {
+            const int c = static_cast<unsigned char>(ch_);
+            return split_block_next(reinterpret_cast<const unsigned char*>(s), n, b,
+                [c](const unsigned char* p, std::size_t k) noexcept { return simd::match_mask(p, k, c); },
+                [c](const unsigned char* p, std::size_t k) noexcept { return simd::memchr(p, c, k); });
+        }
+    };
+
+    // Split delimiter, any character of a set
+    template<
+        typename CharT = char,
+        typename Traits = std::char_traits<CharT>
+    >
+    class split_on_any {
+        basic_sstring_charset<CharT, Traits> set_;
+
+    public:
+        using size_type = std::size_t;
+
+        explicit constexpr split_on_any(const basic_sstring_charset<CharT, Traits>& set) noexcept : set_(set) {}
+
+        // @brief delimiter length
+        constexpr size_type width() const noexcept {
+            return 1;
+        }
+
+        // @brief next delimiter in [from, n), the block cursor already stands at from
+        size_type next(const CharT* s, size_type n, size_type, split_block& b) const noexcept {
+            const simd::byte_set& set = set_.bytes();
+            return split_block_next(reinterpret_cast<const unsigned char*>(s), n, b,
+                [&set](const unsigned char* p, std::size_t k) noexcept { return simd::set_match_mask(p, k, set); },
+                [&set](const unsigned char* p, std::size_t k) noexcept { return simd::find_in_set(p, k, set, true); });
+        }
+    };
+
+    // Split delimiter, a string, an empty one never matches
+    template<
+        typename CharT = char,
+        typename Traits = std::char_traits<CharT>
+    >
+    class split_on_string {
+        basic_sstring_searcher<CharT, Traits> searcher_;
+
+    public:
+        using size_type = std::size_t;
+
+        explicit split_on_string(std::basic_string_view<CharT, Traits> delim) : searcher_(delim) {}
+
+        // @brief delimiter length
+        size_type width() const noexcept {
+            return searcher_.size();
+        }
+
+        // @brief next delimiter in [from, n), matches do not overlap since from is past the previous one
+        size_type next(const CharT* s, size_type n, size_type from, split_block&) const noexcept {
+            return searcher_.find_in(std::basic_string_view<CharT, Traits>(s, n), from);
+        }
+    };
+
+    // Lazy split of a string, yields the pieces between delimiters as string views without allocating;
+    // an empty text has no pieces and a trailing delimiter yields a trailing empty piece
+    template<
+        typename CharT,
+        typename Traits,
+        typename Delim
+    >
+    class basic_sstring_split_view : public std::ranges::view_interface<basic_sstring_split_view<CharT, Traits, Delim>> {
+    // Public types
+    public:
+        using value_type = std::basic_string_view<CharT, Traits>;
+        using size_type = std::size_t;
+        using string_view_type = std::basic_string_view<CharT, Traits>;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        string_view_type text_;
+        Delim delim_;
+
+    public:
+        // Forward iterator over the pieces, it refers back to its view
+        class iterator {
+            const basic_sstring_split_view* owner_ = nullptr;
+            size_type start_ = 0;                // first char of the current piece
+            size_type stop_ = 0;                 // one past its last char, a delimiter or the end
+            split_block block_;
+            bool last_ = true;                   // the current piece runs to the end of the text
+            bool done_ = true;
+
+            // @brief locate the delimiter closing the piece at start_
+            void find_stop() noexcept {
+                const string_view_type text = owner_->text_;
+                const size_type d = owner_->delim_.next(text.data(), text.size(), start_, block_);
+                last_ = d == npos;
+                stop_ = last_ ? text.size() : d;
+            }
+
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = string_view_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = string_view_type;
+
+            iterator() = default;
+            explicit iterator(const basic_sstring_split_view* owner) noexcept : owner_(owner), done_(owner->text_.empty()) {
+                if (!done_) {
+                    find_stop();
+                }
+            }
+
+            // @brief the current piece
+            string_view_type operator*() const noexcept {
+                return string_view_type(owner_->text_.data() + start_, stop_ - start_);
+            }
+
+            // @brief offset of the current piece in the text
+            size_type position() const noexcept {
+                return start_;
+            }
+
+            iterator& operator++() noexcept {
+                if (last_) {
+                    done_ = true;
+                }
+                else {
+                    start_ = stop_ + owner_->delim_.width();
+                    find_stop();
+                }
+                return *this;
+            }
+            iterator operator++(int) noexcept {
+                iterator t = *this;
+                ++*this;
+                return t;
+            }
+
+            friend bool operator==(const iterator& a, const iterator& b) noexcept {
+                return a.done_ == b.done_ && (a.done_ || a.start_ == b.start_);
+            }
+            friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept {
+                return it.done_;
+            }
+        };
+
+    public:
+        basic_sstring_split_view() = default;
+
+        // @brief split text on delim, text must outlive the view
+        basic_sstring_split_view(string_view_type text, Delim delim) : text_(text), delim_(std::move(delim)) {}
+
+        // @brief range access
+        iterator begin() const noexcept {
+            return iterator(this);
+        }
+        std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+
+        // @brief the text being split
+        string_view_type text() const noexcept {
+            return text_;
+        }
+
+        // @brief number of pieces, one scan and no allocation
+        size_type count() const noexcept {
+            size_type k = 0;
+            for (iterator it = begin(); it != end(); ++it) {
+                ++k;
+            }
+            return k;
+        }
+
+        // @brief append every piece to out, counted first so the container grows once
+        template <typename Container>
+        Container& split_to(Container& out) const {
+            if constexpr (requires { out.reserve(out.size()); }) {
+                out.reserve(out.size() + count());
+            }
+            for (iterator it = begin(); it != end(); ++it) {
+                out.emplace_back(*it);
+            }
+            return out;
+        }
+    };
+
+    // convenience aliases for the three split flavours
+    template<typename CharT = char, typename Traits = std::char_traits<CharT>>
+    using basic_sstring_split_char = basic_sstring_split_view<CharT, Traits, split_on_char<CharT, Traits>>;
+    template<typename CharT = char, typename Traits = std::char_traits<CharT>>
+    using basic_sstring_split_any = basic_sstring_split_view<CharT, Traits, split_on_any<CharT, Traits>>;
+    template<typename CharT = char, typename Traits = std::char_traits<CharT>>
+    using basic_sstring_split_string = basic_sstring_split_view<CharT, Traits, split_on_string<CharT, Traits>>;
+
+}
+// namespace libsstring ends
@@ -0,0 +1,1173 @@
+// sstring_simd.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <bit>
+
+// define sstring simd kernels enabled (0 forces the scalar kernels)
+#ifndef _SSTRING_ENABLE_SIMD
+#define _SSTRING_ENABLE_SIMD               1
+#endif
+
+// x86 simd kernels are only compiled when SSE2 is the baseline
+#if _SSTRING_ENABLE_SIMD != 0 && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define _SSTRING_SIMD_X86                  1
+#else
+#define _SSTRING_SIMD_X86                  0
+#endif
+
+#if _SSTRING_SIMD_X86 != 0
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// per-function target attributes, MSVC exposes every intrinsic without them
+#if _SSTRING_SIMD_X86 != 0 && (defined(__GNUC__) || defined(__clang__))
+#define _SSTRING_TARGET_AVX2               __attribute__((target("avx2")))
+#define _SSTRING_TARGET_AVX512BW           __attribute__((target("avx512f,avx512bw")))
+#else
+#define _SSTRING_TARGET_AVX2
+#define _SSTRING_TARGET_AVX512BW
+#endif
+
+// namespace libsstring starts
+namespace libsstring {
+
+// namespace simd starts
+namespace simd {
+
+    // Instruction set levels of the kernel layer
+    enum class simd_level : int {
+        scalar = 0,                              // portable SWAR kernels
+        sse2 = 1,                                // x86 baseline, 16 bytes per step
+        avx2 = 2,                                // 32 bytes per step
+        avx512bw = 3,                            // 64 bytes per step, masked tails
+    };
+
+    // below this length the inline scalar path is cheaper than an indirect call
+    inline constexpr std::size_t short_length = 16;
+
+    // 256-bit byte set with the nibble tables used by the shuffle kernels
+    struct byte_set {
+        std::uint64_t bits[4] = {};              // membership bitmap
+        alignas(16) unsigned char lo[16] = {};   // by low nibble, bit h set when byte (h << 4 | low) is a member, h < 8
+        alignas(16) unsigned char hi[16] = {};   // by low nibble, bit h - 8 for the high nibbles h >= 8
+
+        // @brief add a byte
+        constexpr void add(unsigned char c) noexcept {
+            bits[c >> 6] |= std::uint64_t(1) << (c & 63);
+            if (c < 0x80) {
+                lo[c & 15] |= static_cast<unsigned char>(1u << (c >> 4));
+            }
+            else {
+                hi[c & 15] |= static_cast<unsigned char>(1u << ((c >> 4) - 8));
+            }
+        }
+
+        // @brief test a byte
+        constexpr bool contains(unsigned char c) const noexcept {
+            return ((bits[c >> 6] >> (c & 63)) & 1) != 0;
+        }
+    };
+
+    // kernel signatures
+    using memchr_fn = const void* (*)(const void*, int, std::size_t) noexcept;
+    using find_pair_fn = const void* (*)(const void*, int, int, std::size_t) noexcept;
+    using memcmp_fn = int (*)(const void*, const void*, std::size_t) noexcept;
+    using find_substr_fn = const void* (*)(const void*, std::size_t, const void*, std::size_t) noexcept;
+    using find_in_set_fn = const void* (*)(const void*, std::size_t, const byte_set&, bool) noexcept;
+    using match_mask_fn = std::uint64_t (*)(const void*, std::size_t, int) noexcept;
+    using set_match_mask_fn = std::uint64_t (*)(const void*, std::size_t, const byte_set&) noexcept;
+
+    // @brief SWAR broadcast of a byte to all lanes of a 64-bit word
+    constexpr std::uint64_t swar_broadcast(unsigned char c) noexcept {
+        return 0x0101010101010101ull * c;
+    }
+
+    // @brief SWAR zero-byte mask, the lowest set 0x80 marks the first zero byte
+    constexpr std::uint64_t swar_zero_mask(std::uint64_t w) noexcept {
+        return (w - 0x0101010101010101ull) & ~w & 0x8080808080808080ull;
+    }
+
+    // @brief scalar memchr, 8 bytes per step
+    inline const void* memchr_scalar(const void* buf, int c, std::size_t n) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        const unsigned char ch = static_cast<unsigned char>(c);
+        const std::uint64_t pattern = swar_broadcast(ch);
+        while (n >= 8) {
+            std::uint64_t w;
+            std::memcpy(&w, p, 8);
+            const std::uint64_t z = swar_zero_mask(w ^ pattern);
+            if (z) {
+                return p + (std::countr_zero(z) >> 3);
+            }
+            p += 8;
+            n -= 8;
+        }
+        for (; n; ++p, --n) {
+            if (*p == ch) {
+                return p;
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief scalar adjacent pair search, first i with p[i] == a && p[i + 1] == b
+    inline const void* find_pair_scalar(const void* buf, int a, int b, std::size_t n) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        const unsigned char ca = static_cast<unsigned char>(a);
+        const unsigned char cb = static_cast<unsigned char>(b);
+        if (n < 2) {
+            return nullptr;
+        }
+        const unsigned char* const last = p + n - 1;
+        while (p < last) {
+            p = static_cast<const unsigned char*>(memchr_scalar(p, ca, static_cast<std::size_t>(last - p)));
+            if (!p) {
+                return nullptr;
+            }
+            if (p[1] == cb) {
+                return p;
+            }
+            ++p;
+        }
+        return nullptr;
+    }
+
+    // @brief scalar memcmp, 8 bytes per step, returns the difference of the first mismatching bytes
+    inline int memcmp_scalar(const void* lhs, const void* rhs, std::size_t n) noexcept {
+        const unsigned char* a = static_cast<const unsigned char*>(lhs);
+        const unsigned char* b = static_cast<const unsigned char*>(rhs);
+        while (n >= 8) {
+            std::uint64_t x, y;
+            std::memcpy(&x, a, 8);
+            std::memcpy(&y, b, 8);
+            if (x != y) {
+                const std::size_t k = static_cast<std::size_t>(std::countr_zero(x ^ y) >> 3);
+                return static_cast<int>(a[k]) - static_cast<int>(b[k]);
+            }
+            a += 8;
+            b += 8;
+            n -= 8;
+        }
+        for (; n; ++a, ++b, --n) {
+            if (*a != *b) {
+                return static_cast<int>(*a) - static_cast<int>(*b);
+            }
+        }
+        return 0;
+    }
+
+    // @brief equality of two byte ranges, used to verify substring candidates
+    inline bool equal_bytes(const unsigned char* a, const unsigned char* b, std::size_t n) noexcept {
+        while (n >= 8) {
+            std::uint64_t x, y;
+            std::memcpy(&x, a, 8);
+            std::memcpy(&y, b, 8);
+            if (x != y) {
+                return false;
+            }
+            a += 8;
+            b += 8;
+            n -= 8;
+        }
+        for (; n; ++a, ++b, --n) {
+            if (*a != *b) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // @brief verify the candidates of a first+last byte mask, base is the position of bit 0
+    template <typename Mask>
+    inline const unsigned char* verify_candidates(const unsigned char* h, std::size_t base, Mask mask,
+                                                  const unsigned char* nd, std::size_t m) noexcept {
+        while (mask) {
+            const std::size_t k = base + static_cast<std::size_t>(std::countr_zero(mask));
+            if (equal_bytes(h + k + 1, nd + 1, m - 2)) {
+                return h + k;
+            }
+            mask &= mask - 1;
+        }
+        return nullptr;
+    }
+
+    // @brief scalar substring search, needle is at least 2 bytes, first byte located by memchr then last byte checked
+    inline const void* find_substr_scalar(const void* hay, std::size_t n, const void* needle, std::size_t m) noexcept {
+        const unsigned char* h = static_cast<const unsigned char*>(hay);
+        const unsigned char* nd = static_cast<const unsigned char*>(needle);
+        if (m > n) {
+            return nullptr;
+        }
+        const unsigned char* cur = h;
+        const unsigned char* const end = h + (n - m) + 1;
+        while (cur < end) {
+            cur = static_cast<const unsigned char*>(memchr_scalar(cur, nd[0], static_cast<std::size_t>(end - cur)));
+            if (!cur) {
+                return nullptr;
+            }
+            if (cur[m - 1] == nd[m - 1] && equal_bytes(cur + 1, nd + 1, m - 2)) {
+                return cur;
+            }
+            ++cur;
+        }
+        return nullptr;
+    }
+
+    // @brief scalar set scan, first byte whose membership equals member
+    inline const void* find_in_set_scalar(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (set.contains(p[i]) == member) {
+                return p + i;
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief scalar reverse set scan, last byte whose membership equals member
+    inline const void* rfind_in_set_scalar(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        while (n) {
+            --n;
+            if (set.contains(p[n]) == member) {
+                return p + n;
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief SWAR exact zero-byte mask, 0x80 in every zero byte and no borrow artifacts
+    constexpr std::uint64_t swar_exact_zero_mask(std::uint64_t w) noexcept {
+        const std::uint64_t low7 = 0x7F7F7F7F7F7F7F7Full;
+        return ~(((w & low7) + low7) | w | low7);
+    }
+
+    // @brief pack the 0x80 marker of every byte of a SWAR mask into 8 bits, byte i to bit i
+    constexpr unsigned swar_pack_bits(std::uint64_t m) noexcept {
+        return static_cast<unsigned>(((m >> 7) * 0x0102040810204080ull) >> 56);
+    }
+
+    // @brief scalar block match mask, bit i set when p[i] == c, over the first min(n, 64) bytes
+    inline std::uint64_t match_mask_scalar(const void* buf, std::size_t n, int c) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        const unsigned char ch = static_cast<unsigned char>(c);
+        const std::size_t k = n < 64 ? n : 64;
+        const std::uint64_t pattern = swar_broadcast(ch);
+        std::uint64_t mask = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= k; i += 8) {
+            std::uint64_t w;
+            std::memcpy(&w, p + i, 8);
+            mask |= std::uint64_t(swar_pack_bits(swar_exact_zero_mask(w ^ pattern))) << i;
+        }
+        for (; i < k; ++i) {
+            mask |= std::uint64_t(p[i] == ch) << i;
+        }
+        return mask;
+    }
+
+    // @brief scalar block membership mask, bit i set when p[i] is in set, over the first min(n, 64) bytes
+    inline std::uint64_t set_match_mask_scalar(const void* buf, std::size_t n, const byte_set& set) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        const std::size_t k = n < 64 ? n : 64;
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < k; ++i) {
+            mask |= std::uint64_t(set.contains(p[i])) << i;
+        }
+        return mask;
+    }
+
+#if _SSTRING_SIMD_X86 != 0
+
+    // @brief sse2 memchr, overlapping final block instead of a scalar tail
+    inline const void* memchr_sse2(const void* buf, int c, std::size_t n) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        if (n < 16) {
+            return memchr_scalar(p, c, n);
+        }
+        const unsigned char* const end = p + n;
+        const __m128i v = _mm_set1_epi8(static_cast<char>(c));
+        for (; p + 16 <= end; p += 16) {
+            const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), v)));
+            if (m) {
+                return p + std::countr_zero(m);
+            }
+        }
+        if (p != end) {
+            // bytes before p are known not to match, so the first hit is the answer
+            const unsigned char* q = end - 16;
+            const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(q)), v)));
+            if (m) {
+                return q + std::countr_zero(m);
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief sse2 adjacent pair search
+    inline const void* find_pair_sse2(const void* buf, int a, int b, std::size_t n) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        if (n < 17) {
+            return find_pair_scalar(p, a, b, n);
+        }
+        const unsigned char* const end = p + n;
+        const __m128i va = _mm_set1_epi8(static_cast<char>(a));
+        const __m128i vb = _mm_set1_epi8(static_cast<char>(b));
+        auto block = [&](const unsigned char* q) noexcept {
+            const __m128i x = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(q)), va);
+            const __m128i y = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(q + 1)), vb);
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(x, y)));
+        };
+        for (; p + 17 <= end; p += 16) {
+            const unsigned m = block(p);
+            if (m) {
+                return p + std::countr_zero(m);
+            }
+        }
+        if (p + 1 < end) {
+            const unsigned char* q = end - 17;
+            const unsigned m = block(q);
+            if (m) {
+                return q + std::countr_zero(m);
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief sse2 memcmp
+    inline int memcmp_sse2(const void* lhs, const void* rhs, std::size_t n) noexcept {
+        const unsigned char* a = static_cast<const unsigned char*>(lhs);
+        const unsigned char* b = static_cast<const unsigned char*>(rhs);
+        if (n < 16) {
+            return memcmp_scalar(a, b, n);
+        }
+        auto block = [&](std::size_t i) noexcept {
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i))))) ^ 0xFFFFu;
+        };
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const unsigned m = block(i);
+            if (m) {
+                const std::size_t k = i + std::countr_zero(m);
+                return static_cast<int>(a[k]) - static_cast<int>(b[k]);
+            }
+        }
+        if (i != n) {
+            i = n - 16;
+            const unsigned m = block(i);
+            if (m) {
+                const std::size_t k = i + std::countr_zero(m);
+                return static_cast<int>(a[k]) - static_cast<int>(b[k]);
+            }
+        }
+        return 0;
+    }
+
+    // @brief sse2 substring search, filters candidates by the first and last needle bytes
+    inline const void* find_substr_sse2(const void* hay, std::size_t n, const void* needle, std::size_t m) noexcept {
+        const unsigned char* h = static_cast<const unsigned char*>(hay);
+        const unsigned char* nd = static_cast<const unsigned char*>(needle);
+        if (m > n || n - m + 1 < 16) {
+            return find_substr_scalar(h, n, nd, m);
+        }
+        // candidates are [0, count)
+        const std::size_t count = n - m + 1;
+        const __m128i vf = _mm_set1_epi8(static_cast<char>(nd[0]));
+        const __m128i vl = _mm_set1_epi8(static_cast<char>(nd[m - 1]));
+        auto block = [&](std::size_t i) noexcept {
+            const __m128i x = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i)), vf);
+            const __m128i y = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + m - 1)), vl);
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(x, y)));
+        };
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            if (const unsigned mask = block(i)) {
+                if (const unsigned char* r = verify_candidates(h, i, mask, nd, m)) {
+                    return r;
+                }
+            }
+        }
+        if (i < count) {
+            // overlapping final block, positions below i were already rejected
+            const std::size_t j = count - 16;
+            const unsigned mask = block(j) & ~((1u << (i - j)) - 1u);
+            return verify_candidates(h, j, mask, nd, m);
+        }
+        return nullptr;
+    }
+
+    // @brief sse2 block match mask, four 16-byte compares, short tails go scalar
+    inline std::uint64_t match_mask_sse2(const void* buf, std::size_t n, int c) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        if (n < 64) {
+            return match_mask_scalar(p, n, c);
+        }
+        const __m128i v = _mm_set1_epi8(static_cast<char>(c));
+        std::uint64_t mask = 0;
+        for (int i = 0; i < 4; ++i) {
+            const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i)), v)));
+            mask |= std::uint64_t(m) << (16 * i);
+        }
+        return mask;
+    }
+
+    // @brief avx2 equality mask of the 32 bytes at q
+    _SSTRING_TARGET_AVX2
+    inline unsigned eq_mask_avx2(const unsigned char* q, __m256i v) noexcept {
+        return static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(q)), v)));
+    }
+
+    // @brief avx2 adjacent pair mask of the 32 positions at q
+    _SSTRING_TARGET_AVX2
+    inline unsigned pair_mask_avx2(const unsigned char* q, __m256i va, __m256i vb) noexcept {
+        const __m256i x = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(q)), va);
+        const __m256i y = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + 1)), vb);
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(x, y)));
+    }
+
+    // @brief avx2 mismatch mask of the 32 bytes at a and b
+    _SSTRING_TARGET_AVX2
+    inline unsigned neq_mask_avx2(const unsigned char* a, const unsigned char* b) noexcept {
+        return ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)))));
+    }
+
+    // @brief avx2 first+last byte candidate mask of the 32 positions at q
+    _SSTRING_TARGET_AVX2
+    inline unsigned first_last_mask_avx2(const unsigned char* q, std::size_t m, __m256i vf, __m256i vl) noexcept {
+        const __m256i x = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(q)), vf);
+        const __m256i y = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(q + m - 1)), vl);
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(x, y)));
+    }
+
+    // @brief avx2 memchr, 128 bytes per unrolled step for long scans
+    _SSTRING_TARGET_AVX2
+    inline const void* memchr_avx2(const void* buf, int c, std::size_t n) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        if (n < 32) {
+            return memchr_sse2(p, c, n);
+        }
+        const unsigned char* const end = p + n;
+        const __m256i v = _mm256_set1_epi8(static_cast<char>(c));
+        for (; p + 128 <= end; p += 128) {
+            const __m256i e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), v);
+            const __m256i e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), v);
+            const __m256i e2 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 64)), v);
+            const __m256i e3 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 96)), v);
+            const __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+            if (!_mm256_testz_si256(any, any)) {
+                for (int k = 0; k < 4; ++k) {
+                    const unsigned m = eq_mask_avx2(p + 32 * k, v);
+                    if (m) {
+                        return p + 32 * k + std::countr_zero(m);
+                    }
+                }
+            }
+        }
+        for (; p + 32 <= end; p += 32) {
+            const unsigned m = eq_mask_avx2(p, v);
+            if (m) {
+                return p + std::countr_zero(m);
+            }
+        }
+        if (p != end) {
+            const unsigned char* q = end - 32;
+            const unsigned m = eq_mask_avx2(q, v);
+            if (m) {
+                return q + std::countr_zero(m);
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief avx2 adjacent pair search
+    _SSTRING_TARGET_AVX2
+    inline const void* find_pair_avx2(const void* buf, int a, int b, std::size_t n) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        if (n < 33) {
+            return find_pair_sse2(p, a, b, n);
+        }
+        const unsigned char* const end = p + n;
+        const __m256i va = _mm256_set1_epi8(static_cast<char>(a));
+        const __m256i vb = _mm256_set1_epi8(static_cast<char>(b));
+        for (; p + 33 <= end; p += 32) {
+            const unsigned m = pair_mask_avx2(p, va, vb);
+            if (m) {
+                return p + std::countr_zero(m);
+            }
+        }
+        if (p + 1 < end) {
+            const unsigned char* q = end - 33;
+            const unsigned m = pair_mask_avx2(q, va, vb);
+            if (m) {
+                return q + std::countr_zero(m);
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief avx2 memcmp
+    _SSTRING_TARGET_AVX2
+    inline int memcmp_avx2(const void* lhs, const void* rhs, std::size_t n) noexcept {
+        const unsigned char* a = static_cast<const unsigned char*>(lhs);
+        const unsigned char* b = static_cast<const unsigned char*>(rhs);
+        if (n < 32) {
+            return memcmp_sse2(a, b, n);
+        }
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const unsigned m = neq_mask_avx2(a + i, b + i);
+            if (m) {
+                const std::size_t k = i + std::countr_zero(m);
+                return static_cast<int>(a[k]) - static_cast<int>(b[k]);
+            }
+        }
+        if (i != n) {
+            i = n - 32;
+            const unsigned m = neq_mask_avx2(a + i, b + i);
+            if (m) {
+                const std::size_t k = i + std::countr_zero(m);
+                return static_cast<int>(a[k]) - static_cast<int>(b[k]);
+            }
+        }
+        return 0;
+    }
+
+    // @brief avx2 substring search, filters candidates by the first and last needle bytes
+    _SSTRING_TARGET_AVX2
+    inline const void* find_substr_avx2(const void* hay, std::size_t n, const void* needle, std::size_t m) noexcept {
+        const unsigned char* h = static_cast<const unsigned char*>(hay);
+        const unsigned char* nd = static_cast<const unsigned char*>(needle);
+        if (m > n || n - m + 1 < 32) {
+            return find_substr_sse2(h, n, nd, m);
+        }
+        const std::size_t count = n - m + 1;
+        const __m256i vf = _mm256_set1_epi8(static_cast<char>(nd[0]));
+        const __m256i vl = _mm256_set1_epi8(static_cast<char>(nd[m - 1]));
+        std::size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            if (const unsigned mask = first_last_mask_avx2(h + i, m, vf, vl)) {
+                if (const unsigned char* r = verify_candidates(h, i, mask, nd, m)) {
+                    return r;
+                }
+            }
+        }
+        if (i < count) {
+            const std::size_t j = count - 32;
+            const unsigned mask = first_last_mask_avx2(h + j, m, vf, vl) & ~((1u << (i - j)) - 1u);
+            return verify_candidates(h, j, mask, nd, m);
+        }
+        return nullptr;
+    }
+
+    // @brief avx2 membership mask of the 32 bytes at q, nibble tables looked up with vpshufb
+    _SSTRING_TARGET_AVX2
+    inline unsigned set_mask_avx2(const unsigned char* q, __m256i lut_lo, __m256i lut_hi, __m256i bit_tab) noexcept {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q));
+        // bit 7 zeroes a shuffle lane, so each table only answers for its half of the byte range
+        const __m256i idx = _mm256_and_si256(x, _mm256_set1_epi8(static_cast<char>(0x8F)));
+        const __m256i row = _mm256_or_si256(_mm256_shuffle_epi8(lut_lo, idx),
+            _mm256_shuffle_epi8(lut_hi, _mm256_xor_si256(idx, _mm256_set1_epi8(static_cast<char>(0x80)))));
+        const __m256i bit = _mm256_shuffle_epi8(bit_tab, _mm256_and_si256(_mm256_srli_epi16(x, 4), _mm256_set1_epi8(0x0F)));
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit)));
+    }
+
+    // @brief avx2 nibble tables of a byte set, broadcast to both 128-bit lanes
+    _SSTRING_TARGET_AVX2
+    inline void set_tables_avx2(const byte_set& set, __m256i& lut_lo, __m256i& lut_hi, __m256i& bit_tab) noexcept {
+        lut_lo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.lo)));
+        lut_hi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(set.hi)));
+        bit_tab = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                   1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    }
+
+    // @brief avx2 set scan
+    _SSTRING_TARGET_AVX2
+    inline const void* find_in_set_avx2(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        if (n < 32) {
+            return find_in_set_scalar(p, n, set, member);
+        }
+        __m256i lut_lo, lut_hi, bit_tab;
+        set_tables_avx2(set, lut_lo, lut_hi, bit_tab);
+        const unsigned flip = member ? 0u : ~0u;
+        std::size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const unsigned m = set_mask_avx2(p + i, lut_lo, lut_hi, bit_tab) ^ flip;
+            if (m) {
+                return p + i + std::countr_zero(m);
+            }
+        }
+        if (i < n) {
+            const std::size_t j = n - 32;
+            const unsigned m = (set_mask_avx2(p + j, lut_lo, lut_hi, bit_tab) ^ flip) & ~((1u << (i - j)) - 1u);
+            if (m) {
+                return p + j + std::countr_zero(m);
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief avx2 reverse set scan
+    _SSTRING_TARGET_AVX2
+    inline const void* rfind_in_set_avx2(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        if (n < 32) {
+            return rfind_in_set_scalar(p, n, set, member);
+        }
+        __m256i lut_lo, lut_hi, bit_tab;
+        set_tables_avx2(set, lut_lo, lut_hi, bit_tab);
+        const unsigned flip = member ? 0u : ~0u;
+        std::size_t i = n;
+        for (; i >= 32; i -= 32) {
+            const unsigned m = set_mask_avx2(p + i - 32, lut_lo, lut_hi, bit_tab) ^ flip;
+            if (m) {
+                return p + i - 1 - std::countl_zero(m);
+            }
+        }
+        if (i) {
+            // overlapping head block, bytes from i on were already rejected
+            const unsigned m = (set_mask_avx2(p, lut_lo, lut_hi, bit_tab) ^ flip) & ((1u << i) - 1u);
+            if (m) {
+                return p + 31 - std::countl_zero(m);
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief avx2 block match mask, two 32-byte compares, short tails go scalar
+    _SSTRING_TARGET_AVX2
+    inline std::uint64_t match_mask_avx2(const void* buf, std::size_t n, int c) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        if (n < 64) {
+            return match_mask_scalar(p, n, c);
+        }
+        const __m256i v = _mm256_set1_epi8(static_cast<char>(c));
+        return std::uint64_t(eq_mask_avx2(p, v)) | (std::uint64_t(eq_mask_avx2(p + 32, v)) << 32);
+    }
+
+    // @brief avx2 block membership mask, short tails go scalar
+    _SSTRING_TARGET_AVX2
+    inline std::uint64_t set_match_mask_avx2(const void* buf, std::size_t n, const byte_set& set) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        if (n < 64) {
+            return set_match_mask_scalar(p, n, set);
+        }
+        __m256i lut_lo, lut_hi, bit_tab;
+        set_tables_avx2(set, lut_lo, lut_hi, bit_tab);
+        return std::uint64_t(set_mask_avx2(p, lut_lo, lut_hi, bit_tab))
+            | (std::uint64_t(set_mask_avx2(p + 32, lut_lo, lut_hi, bit_tab)) << 32);
+    }
+
+    // @brief mask of the lowest n lanes of a 64-lane vector, n in [0, 64]
+    constexpr std::uint64_t lane_mask64(std::size_t n) noexcept {
+        return n >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << n) - 1;
+    }
+
+    // @brief avx512bw memchr, masked loads cover the tail without touching memory past the end
+    _SSTRING_TARGET_AVX512BW
+    inline const void* memchr_avx512bw(const void* buf, int c, std::size_t n) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        const unsigned char* const end = p + n;
+        const __m512i v = _mm512_set1_epi8(static_cast<char>(c));
+        for (; p + 256 <= end; p += 256) {
+            const std::uint64_t m0 = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p), v);
+            const std::uint64_t m1 = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p + 64), v);
+            const std::uint64_t m2 = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p + 128), v);
+            const std::uint64_t m3 = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p + 192), v);
+            if (m0 | m1 | m2 | m3) {
+                if (m0) return p + std::countr_zero(m0);
+                if (m1) return p + 64 + std::countr_zero(m1);
+                if (m2) return p + 128 + std::countr_zero(m2);
+                return p + 192 + std::countr_zero(m3);
+            }
+        }
+        for (; p + 64 <= end; p += 64) {
+            const std::uint64_t m = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p), v);
+            if (m) {
+                return p + std::countr_zero(m);
+            }
+        }
+        if (p != end) {
+            const __mmask64 lanes = lane_mask64(static_cast<std::size_t>(end - p));
+            const std::uint64_t m = _mm512_mask_cmpeq_epi8_mask(lanes, _mm512_maskz_loadu_epi8(lanes, p), v);
+            if (m) {
+                return p + std::countr_zero(m);
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief avx512bw adjacent pair search
+    _SSTRING_TARGET_AVX512BW
+    inline const void* find_pair_avx512bw(const void* buf, int a, int b, std::size_t n) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        if (n < 2) {
+            return nullptr;
+        }
+        // candidate positions are [0, n - 1)
+        const unsigned char* const last = p + n - 1;
+        const __m512i va = _mm512_set1_epi8(static_cast<char>(a));
+        const __m512i vb = _mm512_set1_epi8(static_cast<char>(b));
+        for (; p + 64 <= last; p += 64) {
+            const std::uint64_t m = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p), va)
+                                  & _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p + 1), vb);
+            if (m) {
+                return p + std::countr_zero(m);
+            }
+        }
+        if (p != last) {
+            const __mmask64 lanes = lane_mask64(static_cast<std::size_t>(last - p));
+            const std::uint64_t m = _mm512_mask_cmpeq_epi8_mask(lanes, _mm512_maskz_loadu_epi8(lanes, p), va)
+                                  & _mm512_mask_cmpeq_epi8_mask(lanes, _mm512_maskz_loadu_epi8(lanes, p + 1), vb);
+            if (m) {
+                return p + std::countr_zero(m);
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief avx512bw memcmp
+    _SSTRING_TARGET_AVX512BW
+    inline int memcmp_avx512bw(const void* lhs, const void* rhs, std::size_t n) noexcept {
+        const unsigned char* a = static_cast<const unsigned char*>(lhs);
+        const unsigned char* b = static_cast<const unsigned char*>(rhs);
+        std::size_t i = 0;
+        for (; i + 64 <= n; i += 64) {
+            const std::uint64_t m = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+            if (m) {
+                const std::size_t k = i + std::countr_zero(m);
+                return static_cast<int>(a[k]) - static_cast<int>(b[k]);
+            }
+        }
+        if (i != n) {
+            const __mmask64 lanes = lane_mask64(n - i);
+            const std::uint64_t m = _mm512_mask_cmpneq_epi8_mask(lanes,
+                _mm512_maskz_loadu_epi8(lanes, a + i), _mm512_maskz_loadu_epi8(lanes, b + i));
+            if (m) {
+                const std::size_t k = i + std::countr_zero(m);
+                return static_cast<int>(a[k]) - static_cast<int>(b[k]);
+            }
+        }
+        return 0;
+    }
+
+    // @brief avx512bw substring search, filters candidates by the first and last needle bytes
+    _SSTRING_TARGET_AVX512BW
+    inline const void* find_substr_avx512bw(const void* hay, std::size_t n, const void* needle, std::size_t m) noexcept {
+        const unsigned char* h = static_cast<const unsigned char*>(hay);
+        const unsigned char* nd = static_cast<const unsigned char*>(needle);
+        if (m > n) {
+            return nullptr;
+        }
+        const std::size_t count = n - m + 1;
+        const __m512i vf = _mm512_set1_epi8(static_cast<char>(nd[0]));
+        const __m512i vl = _mm512_set1_epi8(static_cast<char>(nd[m - 1]));
+        std::size_t i = 0;
+        for (; i + 64 <= count; i += 64) {
+            const std::uint64_t mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(h + i), vf)
+                                     & _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(h + i + m - 1), vl);
+            if (mask) {
+                if (const unsigned char* r = verify_candidates(h, i, mask, nd, m)) {
+                    return r;
+                }
+            }
+        }
+        if (i < count) {
+            const __mmask64 lanes = lane_mask64(count - i);
+            const std::uint64_t mask = _mm512_mask_cmpeq_epi8_mask(lanes, _mm512_maskz_loadu_epi8(lanes, h + i), vf)
+                                     & _mm512_mask_cmpeq_epi8_mask(lanes, _mm512_maskz_loadu_epi8(lanes, h + i + m - 1), vl);
+            return verify_candidates(h, i, mask, nd, m);
+        }
+        return nullptr;
+    }
+
+    // @brief avx512bw membership mask of 64 loaded bytes
+    _SSTRING_TARGET_AVX512BW
+    inline std::uint64_t set_mask_avx512bw(__m512i x, __m512i lut_lo, __m512i lut_hi, __m512i bit_tab) noexcept {
+        const __m512i idx = _mm512_and_si512(x, _mm512_set1_epi8(static_cast<char>(0x8F)));
+        const __m512i row = _mm512_or_si512(_mm512_shuffle_epi8(lut_lo, idx),
+            _mm512_shuffle_epi8(lut_hi, _mm512_xor_si512(idx, _mm512_set1_epi8(static_cast<char>(0x80)))));
+        const __m512i bit = _mm512_shuffle_epi8(bit_tab, _mm512_and_si512(_mm512_srli_epi16(x, 4), _mm512_set1_epi8(0x0F)));
+        return _mm512_test_epi8_mask(row, bit);
+    }
+
+    // @brief avx512bw nibble tables of a byte set, broadcast to all 128-bit lanes
+    _SSTRING_TARGET_AVX512BW
+    inline void set_tables_avx512bw(const byte_set& set, __m512i& lut_lo, __m512i& lut_hi, __m512i& bit_tab) noexcept {
+        int lo[4], hi[4];
+        std::memcpy(lo, set.lo, 16);
+        std::memcpy(hi, set.hi, 16);
+        lut_lo = _mm512_set4_epi32(lo[3], lo[2], lo[1], lo[0]);
+        lut_hi = _mm512_set4_epi32(hi[3], hi[2], hi[1], hi[0]);
+        bit_tab = _mm512_set4_epi32(static_cast<int>(0x80402010u), 0x08040201, static_cast<int>(0x80402010u), 0x08040201);
+    }
+
+    // @brief avx512bw set scan
+    _SSTRING_TARGET_AVX512BW
+    inline const void* find_in_set_avx512bw(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        __m512i lut_lo, lut_hi, bit_tab;
+        set_tables_avx512bw(set, lut_lo, lut_hi, bit_tab);
+        const std::uint64_t flip = member ? 0u : ~std::uint64_t(0);
+        std::size_t i = 0;
+        for (; i + 64 <= n; i += 64) {
+            const std::uint64_t m = set_mask_avx512bw(_mm512_loadu_si512(p + i), lut_lo, lut_hi, bit_tab) ^ flip;
+            if (m) {
+                return p + i + std::countr_zero(m);
+            }
+        }
+        if (i < n) {
+            const __mmask64 lanes = lane_mask64(n - i);
+            const std::uint64_t m = (set_mask_avx512bw(_mm512_maskz_loadu_epi8(lanes, p + i), lut_lo, lut_hi, bit_tab) ^ flip) & lanes;
+            if (m) {
+                return p + i + std::countr_zero(m);
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief avx512bw reverse set scan
+    _SSTRING_TARGET_AVX512BW
+    inline const void* rfind_in_set_avx512bw(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(buf);
+        __m512i lut_lo, lut_hi, bit_tab;
+        set_tables_avx512bw(set, lut_lo, lut_hi, bit_tab);
+        const std::uint64_t flip = member ? 0u : ~std::uint64_t(0);
+        std::size_t i = n;
+        for (; i >= 64; i -= 64) {
+            const std::uint64_t m = set_mask_avx512bw(_mm512_loadu_si512(p + i - 64), lut_lo, lut_hi, bit_tab) ^ flip;
+            if (m) {
+                return p + i - 1 - std::countl_zero(m);
+            }
+        }
+        if (i) {
+            const __mmask64 lanes = lane_mask64(i);
+            const std::uint64_t m = (set_mask_avx512bw(_mm512_maskz_loadu_epi8(lanes, p), lut_lo, lut_hi, bit_tab) ^ flip) & lanes;
+            if (m) {
+                return p + 63 - std::countl_zero(m);
+            }
+        }
+        return nullptr;
+    }
+
+    // @brief avx512bw block match mask, one masked compare
+    _SSTRING_TARGET_AVX512BW
+    inline std::uint64_t match_mask_avx512bw(const void* buf, std::size_t n, int c) noexcept {
+        const __mmask64 lanes = lane_mask64(n);
+        return _mm512_mask_cmpeq_epi8_mask(lanes, _mm512_maskz_loadu_epi8(lanes, buf), _mm512_set1_epi8(static_cast<char>(c)));
+    }
+
+    // @brief avx512bw block membership mask
+    _SSTRING_TARGET_AVX512BW
+    inline std::uint64_t set_match_mask_avx512bw(const void* buf, std::size_t n, const byte_set& set) noexcept {
+        __m512i lut_lo, lut_hi, bit_tab;
+        set_tables_avx512bw(set, lut_lo, lut_hi, bit_tab);
+        const __mmask64 lanes = lane_mask64(n);
+        return set_mask_avx512bw(_mm512_maskz_loadu_epi8(lanes, buf), lut_lo, lut_hi, bit_tab) & lanes;
+    }
+
+    // @brief raw cpuid, returns eax ebx ecx edx
+    inline void cpuid(unsigned leaf, unsigned subleaf, unsigned (&r)[4]) noexcept {
+        #if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4];
+        __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+        for (int i = 0; i < 4; ++i) {
+            r[i] = static_cast<unsigned>(regs[i]);
+        }
+        #else
+        __cpuid_count(leaf, subleaf, r[0], r[1], r[2], r[3]);
+        #endif
+    }
+
+    // @brief read XCR0 to see which register states the OS saves
+    inline std::uint64_t xgetbv0() noexcept {
+        #if defined(_MSC_VER) && !defined(__clang__)
+        return _xgetbv(0);
+        #else
+        unsigned lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return (static_cast<std::uint64_t>(hi) << 32) | lo;
+        #endif
+    }
+
+#endif
+
+    // @brief detect the best level supported by both the cpu and the OS
+    inline simd_level detect_level() noexcept {
+        #if _SSTRING_SIMD_X86 != 0
+        unsigned r[4];
+        cpuid(0, 0, r);
+        const unsigned max_leaf = r[0];
+        cpuid(1, 0, r);
+        const bool osxsave = (r[2] & (1u << 27)) != 0;
+        const bool avx = (r[2] & (1u << 28)) != 0;
+        if (!osxsave || !avx || max_leaf < 7) {
+            return simd_level::sse2;
+        }
+        const std::uint64_t xcr0 = xgetbv0();
+        if ((xcr0 & 0x6) != 0x6) {
+            return simd_level::sse2;
+        }
+        cpuid(7, 0, r);
+        const bool avx2 = (r[1] & (1u << 5)) != 0;
+        const bool avx512f = (r[1] & (1u << 16)) != 0;
+        const bool avx512bw = (r[1] & (1u << 30)) != 0;
+        if (avx512f && avx512bw && (xcr0 & 0xE6) == 0xE6) {
+            return simd_level::avx512bw;
+        }
+        return avx2 ? simd_level::avx2 : simd_level::sse2;
+        #else
+        return simd_level::scalar;
+        #endif
+    }
+
+    // resolvers, each installs the kernel table on its first call
+    inline const void* memchr_resolve(const void* buf, int c, std::size_t n) noexcept;
+    inline const void* find_pair_resolve(const void* buf, int a, int b, std::size_t n) noexcept;
+    inline int memcmp_resolve(const void* lhs, const void* rhs, std::size_t n) noexcept;
+    inline const void* find_substr_resolve(const void* hay, std::size_t n, const void* needle, std::size_t m) noexcept;
+    inline const void* find_in_set_resolve(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept;
+    inline const void* rfind_in_set_resolve(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept;
+    inline std::uint64_t match_mask_resolve(const void* buf, std::size_t n, int c) noexcept;
+    inline std::uint64_t set_match_mask_resolve(const void* buf, std::size_t n, const byte_set& set) noexcept;
+
+    // dispatch table, constant-initialized so it is usable during static initialization
+    inline std::atomic<memchr_fn> dispatch_memchr{ &memchr_resolve };
+    inline std::atomic<find_pair_fn> dispatch_find_pair{ &find_pair_resolve };
+    inline std::atomic<memcmp_fn> dispatch_memcmp{ &memcmp_resolve };
+    inline std::atomic<find_substr_fn> dispatch_find_substr{ &find_substr_resolve };
+    inline std::atomic<find_in_set_fn> dispatch_find_in_set{ &find_in_set_resolve };
+    inline std::atomic<find_in_set_fn> dispatch_rfind_in_set{ &rfind_in_set_resolve };
+    inline std::atomic<match_mask_fn> dispatch_match_mask{ &match_mask_resolve };
+    inline std::atomic<set_match_mask_fn> dispatch_set_match_mask{ &set_match_mask_resolve };
+    inline std::atomic<simd_level> dispatch_level{ simd_level::scalar };
+
+    // @brief install the kernels of a level, clamped to what this machine supports, returns the installed level
+    inline simd_level set_level(simd_level want) noexcept {
+        const simd_level best = detect_level();
+        const simd_level lvl = static_cast<int>(want) < static_cast<int>(best) ? want : best;
+        memchr_fn f_chr = &memchr_scalar;
+        find_pair_fn f_pair = &find_pair_scalar;
+        memcmp_fn f_cmp = &memcmp_scalar;
+        find_substr_fn f_sub = &find_substr_scalar;
+        find_in_set_fn f_set = &find_in_set_scalar;
+        find_in_set_fn f_rset = &rfind_in_set_scalar;
+        match_mask_fn f_mask = &match_mask_scalar;
+        set_match_mask_fn f_smask = &set_match_mask_scalar;
+        #if _SSTRING_SIMD_X86 != 0
+        switch (lvl) {
+        case simd_level::avx512bw:
+            f_chr = &memchr_avx512bw;
+            f_pair = &find_pair_avx512bw;
+            f_cmp = &memcmp_avx512bw;
+            f_sub = &find_substr_avx512bw;
+            f_set = &find_in_set_avx512bw;
+            f_rset = &rfind_in_set_avx512bw;
+            f_mask = &match_mask_avx512bw;
+            f_smask = &set_match_mask_avx512bw;
+            break;
+        case simd_level::avx2:
+            f_chr = &memchr_avx2;
+            f_pair = &find_pair_avx2;
+            f_cmp = &memcmp_avx2;
+            f_sub = &find_substr_avx2;
+            f_set = &find_in_set_avx2;
+            f_rset = &rfind_in_set_avx2;
+            f_mask = &match_mask_avx2;
+            f_smask = &set_match_mask_avx2;
+            break;
+        case simd_level::sse2:
+            f_chr = &memchr_sse2;
+            f_pair = &find_pair_sse2;
+            f_cmp = &memcmp_sse2;
+            f_sub = &find_substr_sse2;
+            f_mask = &match_mask_sse2;
+            // set scans need pshufb, sse2 keeps the bitmap kernels
+            break;
+        default:
+            break;
+        }
+        #endif
+        dispatch_memchr.store(f_chr, std::memory_order_relaxed);
+        dispatch_find_pair.store(f_pair, std::memory_order_relaxed);
+        dispatch_memcmp.store(f_cmp, std::memory_order_relaxed);
+        dispatch_find_substr.store(f_sub, std::memory_order_relaxed);
+        dispatch_find_in_set.store(f_set, std::memory_order_relaxed);
+        dispatch_rfind_in_set.store(f_rset, std::memory_order_relaxed);
+        dispatch_match_mask.store(f_mask, std::memory_order_relaxed);
+        dispatch_set_match_mask.store(f_smask, std::memory_order_relaxed);
+        dispatch_level.store(lvl, std::memory_order_relaxed);
+        return lvl;
+    }
+
+    // @brief the level currently installed, resolving it if nothing ran yet
+    inline simd_level level() noexcept {
+        if (dispatch_memchr.load(std::memory_order_relaxed) == &memchr_resolve) {
+            return set_level(simd_level::avx512bw);
+        }
+        return dispatch_level.load(std::memory_order_relaxed);
+    }
+
+    inline const void* memchr_resolve(const void* buf, int c, std::size_t n) noexcept {
+        set_level(simd_level::avx512bw);
+        return dispatch_memchr.load(std::memory_order_relaxed)(buf, c, n);
+    }
+
+    inline const void* find_pair_resolve(const void* buf, int a, int b, std::size_t n) noexcept {
+        set_level(simd_level::avx512bw);
+        return dispatch_find_pair.load(std::memory_order_relaxed)(buf, a, b, n);
+    }
+
+    inline int memcmp_resolve(const void* lhs, const void* rhs, std::size_t n) noexcept {
+        set_level(simd_level::avx512bw);
+        return dispatch_memcmp.load(std::memory_order_relaxed)(lhs, rhs, n);
+    }
+
+    inline const void* find_substr_resolve(const void* hay, std::size_t n, const void* needle, std::size_t m) noexcept {
+        set_level(simd_level::avx512bw);
+        return dispatch_find_substr.load(std::memory_order_relaxed)(hay, n, needle, m);
+    }
+
+    inline const void* find_in_set_resolve(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept {
+        set_level(simd_level::avx512bw);
+        return dispatch_find_in_set.load(std::memory_order_relaxed)(buf, n, set, member);
+    }
+
+    inline const void* rfind_in_set_resolve(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept {
+        set_level(simd_level::avx512bw);
+        return dispatch_rfind_in_set.load(std::memory_order_relaxed)(buf, n, set, member);
+    }
+
+    inline std::uint64_t match_mask_resolve(const void* buf, std::size_t n, int c) noexcept {
+        set_level(simd_level::avx512bw);
+        return dispatch_match_mask.load(std::memory_order_relaxed)(buf, n, c);
+    }
+
+    inline std::uint64_t set_match_mask_resolve(const void* buf, std::size_t n, const byte_set& set) noexcept {
+        set_level(simd_level::avx512bw);
+        return dispatch_set_match_mask.load(std::memory_order_relaxed)(buf, n, set);
+    }
+
+    // @brief find a byte, short inputs stay inline, long ones go through the dispatched kernel
+    inline const void* memchr(const void* buf, int c, std::size_t n) noexcept {
+        if (n < short_length) {
+            const unsigned char* p = static_cast<const unsigned char*>(buf);
+            const unsigned char ch = static_cast<unsigned char>(c);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (p[i] == ch) {
+                    return p + i;
+                }
+            }
+            return nullptr;
+        }
+        return dispatch_memchr.load(std::memory_order_relaxed)(buf, c, n);
+    }
+
+    // @brief find the first i such that p[i] == a and p[i + 1] == b
+    inline const void* find_pair(const void* buf, int a, int b, std::size_t n) noexcept {
+        if (n < short_length) {
+            return find_pair_scalar(buf, a, b, n);
+        }
+        return dispatch_find_pair.load(std::memory_order_relaxed)(buf, a, b, n);
+    }
+
+    // @brief compare two byte ranges, the sign follows std::memcmp
+    inline int memcmp(const void* lhs, const void* rhs, std::size_t n) noexcept {
+        if (n < short_length) {
+            const unsigned char* a = static_cast<const unsigned char*>(lhs);
+            const unsigned char* b = static_cast<const unsigned char*>(rhs);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (a[i] != b[i]) {
+                    return static_cast<int>(a[i]) - static_cast<int>(b[i]);
+                }
+            }
+            return 0;
+        }
+        return dispatch_memcmp.load(std::memory_order_relaxed)(lhs, rhs, n);
+    }
+
+    // @brief find a needle of at least 2 bytes, cost grows with the needle length so keep needles short
+    inline const void* find_substr(const void* hay, std::size_t n, const void* needle, std::size_t m) noexcept {
+        if (n < short_length) {
+            return find_substr_scalar(hay, n, needle, m);
+        }
+        return dispatch_find_substr.load(std::memory_order_relaxed)(hay, n, needle, m);
+    }
+
+
+    // @brief find the first byte whose membership in set equals member
+    inline const void* find_in_set(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept {
+        if (n < short_length) {
+            return find_in_set_scalar(buf, n, set, member);
+        }
+        return dispatch_find_in_set.load(std::memory_order_relaxed)(buf, n, set, member);
+    }
+
+    // @brief find the last byte whose membership in set equals member
+    inline const void* rfind_in_set(const void* buf, std::size_t n, const byte_set& set, bool member) noexcept {
+        if (n < short_length) {
+            return rfind_in_set_scalar(buf, n, set, member);
+        }
+        return dispatch_rfind_in_set.load(std::memory_order_relaxed)(buf, n, set, member);
+    }
+
+    // @brief bit i set when p[i] == c, over the first min(n, 64) bytes, lets a caller drain a block of hits at once
+    inline std::uint64_t match_mask(const void* buf, std::size_t n, int c) noexcept {
+        return dispatch_match_mask.load(std::memory_order_relaxed)(buf, n, c);
+    }
+
+    // @brief bit i set when p[i] is in set, over the first min(n, 64) bytes
+    inline std::uint64_t set_match_mask(const void* buf, std::size_t n, const byte_set& set) noexcept {
+        return dispatch_set_match_mask.load(std::memory_order_relaxed)(buf, n, set);
+    }
+
+}
+// namespace simd ends
+
+}
+// namespace libsstring ends
@@ -32,64 +32,161 @@
 #include <format>
 #include <ostream>
 #include <istream>
+#include <streambuf>
+#include <locale>
+#include <limits>
+#include <vector>
 #include <functional>
 
 #include "sstring.hpp"
 
+// namespace libsstring starts
+namespace libsstring {
+
+    // Get area of any streambuf, its protected accessors reached through member pointers named via this derived class
+    template<class CharT, class Traits>
+    struct streambuf_get_area : std::basic_streambuf<CharT, Traits> {
+        using streambuf_type = std::basic_streambuf<CharT, Traits>;
+
+        static CharT* next(streambuf_type* sb) {
+            return (sb->*&streambuf_get_area::gptr)();
+        }
+        static CharT* end(streambuf_type* sb) {
+            return (sb->*&streambuf_get_area::egptr)();
+        }
+        // @brief consume n chars already in the get area
+        static void consume(streambuf_type* sb, size_t n) {
+            while (n != 0) {
+                const int k = static_cast<int>(std::min<size_t>(n, static_cast<size_t>(std::numeric_limits<int>::max())));
+                (sb->*&streambuf_get_area::gbump)(k);
+                n -= static_cast<size_t>(k);
+            }
+        }
+    };
+
+}
+// namespace libsstring ends
+
 // namespace std starts
 namespace std {
 
     // ostream << basic_sstring
-    template<class CharT, class Traits, class Alloc>
+    template<class CharT, class Traits, class Alloc, class Flag, size_t Reserved, size_t Align, class Share, class Growth>
     std::basic_ostream<CharT, Traits>&
         operator<<(std::basic_ostream<CharT, Traits>& os,
-            const libsstring::basic_sstring<CharT, Traits, Alloc>& s)
+            const libsstring::basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>& s)
     {
         return os.write(s.data(), s.size());
     }
 
     // istream >> basic_sstring
-    template<class CharT, class Traits, class Alloc>
+    // scans the streambuf's get area in bulk for whitespace and appends whole spans
+    template<class CharT, class Traits, class Alloc, class Flag, size_t Reserved, size_t Align, class Share, class Growth>
     std::basic_istream<CharT, Traits>&
         operator>>(std::basic_istream<CharT, Traits>& is,
-            libsstring::basic_sstring<CharT, Traits, Alloc>& s)
+            libsstring::basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>& s)
     {
+        using get_area = libsstring::streambuf_get_area<CharT, Traits>;
         s.clear();
-        std::basic_string<CharT, Traits> tmp;
-        is >> tmp;
-        s.append(std::basic_string_view<CharT, Traits>(tmp));
+        typename std::basic_istream<CharT, Traits>::sentry sentry(is, false);
+        if (!sentry) return is;
+
+        const std::ctype<CharT>& ct = std::use_facet<std::ctype<CharT>>(is.getloc());
+        const std::streamsize width = is.width();
+        const size_t limit = width > 0 ? static_cast<size_t>(width) : static_cast<size_t>(-1);
+        std::basic_streambuf<CharT, Traits>* sb = is.rdbuf();
+        std::ios_base::iostate state = std::ios_base::goodbit;
+        size_t count = 0;
+        while (count < limit) {
+            // refills only when the get area is empty
+            const auto c = sb->sgetc();
+            if (Traits::eq_int_type(c, Traits::eof())) {
+                state |= std::ios_base::eofbit;
+                break;
+            }
+            const CharT* p = get_area::next(sb);
+            const CharT* e = get_area::end(sb);
+            // unbuffered streambuf, one char at a time
+            if (p == e) {
+                const CharT ch = Traits::to_char_type(c);
+                if (ct.is(std::ctype_base::space, ch)) break;
+                s.push_back(ch);
+                sb->sbumpc();
+                ++count;
+                continue;
+            }
+            if (static_cast<size_t>(e - p) > limit - count) {
+                e = p + (limit - count);
+            }
+            const CharT* stop = ct.scan_is(std::ctype_base::space, p, e);
+            const size_t n = static_cast<size_t>(stop - p);
+            s.append(std::basic_string_view<CharT, Traits>(p, n));
+            get_area::consume(sb, n);
+            count += n;
+            if (stop != e) break;
+        }
+        is.width(0);
+        if (count == 0) {
+            state |= std::ios_base::failbit;
+        }
+        is.setstate(state);
         return is;
     }
 
     // getline(basic_sstring)
-    template<
-        class CharT, class Traits, class Alloc>
-    std::istream& getline(
-        std::istream& is,
-        libsstring::basic_sstring<CharT, Traits, Alloc>& str,
-        CharT delim = '\n'
+    // finds the delimiter in the streambuf's get area with Traits::find (memchr for char) and appends whole spans
+    // str is cleared, not freed, so a loop reading into the same string reuses its buffer
+    template<class CharT, class Traits, class Alloc, class Flag, size_t Reserved, size_t Align, class Share, class Growth>
+    std::basic_istream<CharT, Traits>& getline(
+        std::basic_istream<CharT, Traits>& is,
+        libsstring::basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>& str,
+        CharT delim = CharT('\n')
     ) {
+        using get_area = libsstring::streambuf_get_area<CharT, Traits>;
         str.clear();
-
-        std::istream::sentry sentry(is, true);
+        typename std::basic_istream<CharT, Traits>::sentry sentry(is, true);
         if (!sentry) return is;
 
+        std::basic_streambuf<CharT, Traits>* sb = is.rdbuf();
+        std::ios_base::iostate state = std::ios_base::goodbit;
+        bool extracted = false;
         while (true) {
-            int c = is.rdbuf()->sbumpc();
-            if (c == Traits::eof()) {
-                is.setstate(std::ios::eofbit);
+            // refills only when the get area is empty
+            const auto c = sb->sgetc();
+            if (Traits::eq_int_type(c, Traits::eof())) {
+                state |= std::ios_base::eofbit;
                 break;
             }
-            if (static_cast<CharT>(c) == delim)
+            extracted = true;
+            const CharT* p = get_area::next(sb);
+            const CharT* e = get_area::end(sb);
+            // unbuffered streambuf, one char at a time
+            if (p == e) {
+                sb->sbumpc();
+                const CharT ch = Traits::to_char_type(c);
+                if (Traits::eq(ch, delim)) break;
+                str.push_back(ch);
+                continue;
+            }
+            const CharT* hit = Traits::find(p, static_cast<size_t>(e - p), delim);
+            const size_t n = static_cast<size_t>((hit ? hit : e) - p);
+            str.append(std::basic_string_view<CharT, Traits>(p, n));
+            if (hit) {
+                get_area::consume(sb, n + 1);
                 break;
-            str.push_back(static_cast<CharT>(c));
+            }
+            get_area::consume(sb, n);
+        }
+        if (!extracted) {
+            state |= std::ios_base::failbit;
         }
+        is.setstate(state);
         return is;
     }
 
     // formatter<basic_sstring>
-    template<class CharT, class Traits, class Alloc>
-    struct formatter<libsstring::basic_sstring<CharT, Traits, Alloc>, CharT>
+    template<class CharT, class Traits, class Alloc, class Flag, size_t Reserved, size_t Align, class Share, class Growth>
+    struct formatter<libsstring::basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>, CharT>
     {
         std::formatter<std::basic_string_view<CharT, Traits>, CharT> svfmt;
 
@@ -98,22 +195,85 @@ namespace std {
         }
 
         template<class FormatContext>
-        auto format(const libsstring::basic_sstring<CharT, Traits, Alloc>& s, FormatContext& ctx) const {
+        auto format(const libsstring::basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>& s, FormatContext& ctx) const {
             return svfmt.format(std::basic_string_view<CharT, Traits>(s.data(), s.size()), ctx);
         }
     };
 
     // hash specialization for basic_sstring
-    template<class CharT, class Traits, class Alloc>
-    struct hash<libsstring::basic_sstring<CharT, Traits, Alloc>> {
-        using sstring_type = libsstring::basic_sstring<CharT, Traits, Alloc>;
+    template<class CharT, class Traits, class Alloc, class Flag, size_t Reserved, size_t Align, class Share, class Growth>
+    struct hash<libsstring::basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>> {
+        using sstring_type = libsstring::basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>;
         size_t operator()(const sstring_type& s) const noexcept {
-            // reuse std::hash<string_view>
-            return std::hash<std::basic_string_view<CharT, Traits>>{}(
-                std::basic_string_view<CharT, Traits>(s.data(), s.size())
-                );
+            // heap strings memoize their hash
+            return s.hash();
         }
     };
 
 } 
 // namespace std ends
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // @brief append formatted output to s
+    // the first pass formats into the free tail, SSO buffer or heap, through a plain pointer the formatting library fills in bulk
+    // only output longer than the tail takes a second pass, after reserving the size the first pass measured
+    template<class CharT, class Traits, class Alloc, class Flag, size_t Reserved, size_t Align, class Share, class Growth, class... Args>
+    basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>&
+        format_to(basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>& s,
+            std::basic_format_string<std::type_identity_t<CharT>, std::type_identity_t<Args>...> fmt, Args&&... args)
+    {
+        using size_type = typename basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>::size_type;
+        const size_type cur = s.size();
+        const size_type room = s.capacity() - cur;
+        size_type total = 0;
+        // formatting only reads its arguments, so forwarding them to both passes is safe
+        s.resize_and_overwrite(cur + room, [&](CharT* p, size_type) {
+            total = static_cast<size_type>(std::format_to_n(p + cur, static_cast<std::ptrdiff_t>(room), fmt, std::forward<Args>(args)...).size);
+            return total <= room ? cur + total : cur;
+        });
+        if (total > room) [[unlikely]] {
+            s.resize_and_overwrite(cur + total, [&](CharT* p, size_type n) {
+                std::format_to(p + cur, fmt, std::forward<Args>(args)...);
+                return n;
+            });
+        }
+        return s;
+    }
+
+    // @brief read up to max_lines lines into lines and return how many were read
+    // existing entries are overwritten in place and never erased, so a batch loop reuses their buffers across calls
+    template<class CharT, class Traits, class Alloc, class Flag, size_t Reserved, size_t Align, class Share, class Growth, class VectorAlloc>
+    size_t getlines(std::basic_istream<CharT, Traits>& is,
+        std::vector<basic_sstring<CharT, Traits, Alloc, Flag, Reserved, Align, Share, Growth>, VectorAlloc>& lines,
+        size_t max_lines, CharT delim = CharT('\n'))
+    {
+        size_t n = 0;
+        while (n < max_lines) {
+            const bool appended = n == lines.size();
+            if (appended) {
+                lines.emplace_back();
+            }
+            if (!std::getline(is, lines[n], delim)) {
+                // a failed read must not leave a phantom entry behind
+                if (appended) {
+                    lines.pop_back();
+                }
+                break;
+            }
+            ++n;
+        }
+        return n;
+    }
+
+    // @brief format into a new sstring, results that fit SSO never allocate
+    template<class... Args>
+    sstring format(std::format_string<Args...> fmt, Args&&... args) {
+        sstring s;
+        format_to(s, fmt, std::forward<Args>(args)...);
+        return s;
+    }
+
+}
+// namespace libsstring ends
@@ -0,0 +1,463 @@
+// sstring_thin.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <memory>
+#include <functional>
+#include <bit>
+
+#include "sstring.hpp"
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // One-pointer string, null is empty, a tagged word holds short strings inline and
+    // longer ones live in a heap block whose {size, capacity} header sits in front of the chars
+    template<
+        typename CharT = char,
+        typename Traits = std::char_traits<CharT>,
+        typename Allocator = std::allocator<CharT>
+    >
+    class basic_thin_sstring {
+        static_assert(sizeof(CharT) == 1, "basic_thin_sstring stores chars in the tagged word and supports byte sized CharT only");
+        static_assert(std::endian::native == std::endian::little, "basic_thin_sstring keeps the tag in the lowest byte and requires a little-endian target");
+        static_assert(std::allocator_traits<Allocator>::is_always_equal::value, "basic_thin_sstring has no room for a stateful allocator");
+
+    // Public types
+    public:
+        using value_type = CharT;
+        using traits_type = Traits;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using view_type = std::basic_string_view<CharT, Traits>;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // chars held in the pointer word itself, the lowest byte is the tag
+        static constexpr size_type inline_capacity = sizeof(std::uintptr_t) - 1;
+
+    // Private storage
+    private:
+        // heap block header, the chars follow right behind it
+        struct header {
+            size_type size;                      // length without the null terminator
+            size_type cap;                       // usable chars without the null terminator
+        };
+
+        using word_alloc_type = typename std::allocator_traits<Allocator>::template rebind_alloc<size_type>;
+        using word_alloc_traits = std::allocator_traits<word_alloc_type>;
+
+        static constexpr std::uintptr_t INLINE_TAG = 1;
+        static constexpr size_type HEADER_WORDS = sizeof(header) / sizeof(size_type);
+
+        // 0 empty, odd inline (length in bits 1-3 of the low byte), even heap chars pointer
+        std::uintptr_t bits_ = 0;
+
+    private:
+        // @brief storage state probes
+        constexpr bool is_inline() const noexcept {
+            return (bits_ & INLINE_TAG) != 0;
+        }
+        constexpr bool is_heap() const noexcept {
+            return bits_ != 0 && !is_inline();
+        }
+
+        // @brief heap block access, only valid if is_heap()
+        CharT* heap_chars() const noexcept {
+            return reinterpret_cast<CharT*>(bits_);
+        }
+        header* heap_header() const noexcept {
+            return reinterpret_cast<header*>(bits_) - 1;
+        }
+
+        // @brief inline access, only valid if is_inline()
+        constexpr size_type inline_size() const noexcept {
+            return static_cast<size_type>((bits_ & 0xFF) >> 1);
+        }
+        const CharT* inline_chars() const noexcept {
+            return reinterpret_cast<const CharT*>(&bits_) + 1;
+        }
+
+        // @brief pack up to inline_capacity chars into a tagged word, unused bytes stay zero
+        static std::uintptr_t make_inline(const CharT* s, size_type n) noexcept {
+            std::uintptr_t w = (static_cast<std::uintptr_t>(n) << 1) | INLINE_TAG;
+            if (n) {
+                std::memcpy(reinterpret_cast<unsigned char*>(&w) + 1, s, n);
+            }
+            return w;
+        }
+
+        // @brief allocate a block for at least cap chars plus the terminator, size starts at 0
+        static CharT* allocate_block(size_type cap) {
+            const size_type words = HEADER_WORDS + (cap + sizeof(size_type)) / sizeof(size_type);
+            word_alloc_type alloc;
+            size_type* raw = word_alloc_traits::allocate(alloc, words);
+            header* h = reinterpret_cast<header*>(raw);
+            h->size = 0;
+            h->cap = (words - HEADER_WORDS) * sizeof(size_type) - 1;
+            return reinterpret_cast<CharT*>(h + 1);
+        }
+
+        // @brief release a block returned by allocate_block
+        static void free_block(CharT* chars) noexcept {
+            header* h = reinterpret_cast<header*>(chars) - 1;
+            const size_type words = HEADER_WORDS + (h->cap + 1) / sizeof(size_type);
+            word_alloc_type alloc;
+            word_alloc_traits::deallocate(alloc, reinterpret_cast<size_type*>(h), words);
+        }
+
+        // @brief encode chars in the cheapest form, the caller owns releasing the old word
+        static std::uintptr_t make_word(const CharT* s, size_type n) {
+            if (n == 0) {
+                return 0;
+            }
+            if (n <= inline_capacity) {
+                return make_inline(s, n);
+            }
+            CharT* p = allocate_block(n);
+            std::memcpy(p, s, n);
+            p[n] = CharT();
+            reinterpret_cast<header*>(p)[-1].size = n;
+            return reinterpret_cast<std::uintptr_t>(p);
+        }
+
+        // @brief release the heap block if any and become empty
+        void release() noexcept {
+            if (is_heap()) {
+                free_block(heap_chars());
+            }
+            bits_ = 0;
+        }
+
+    public:
+        // @brief default constructor, empty and allocation free
+        constexpr basic_thin_sstring() noexcept = default;
+
+        // @brief construct from chars
+        basic_thin_sstring(const CharT* s, size_type n) : bits_(make_word(s, n)) {}
+        basic_thin_sstring(view_type sv) : bits_(make_word(sv.data(), sv.size())) {}
+        basic_thin_sstring(const CharT* s) : basic_thin_sstring(view_type(s)) {}
+
+        // @brief construct from any string convertible to a view, e.g. basic_sstring or std::string
+        template<typename S>
+            requires (std::is_convertible_v<const S&, view_type> &&
+                      !std::is_same_v<std::remove_cvref_t<S>, basic_thin_sstring> &&
+                      !std::is_convertible_v<const S&, const CharT*>)
+        explicit basic_thin_sstring(const S& s) : basic_thin_sstring(view_type(s)) {}
+
+        // @brief copy constructor, deep copies heap blocks
+        basic_thin_sstring(const basic_thin_sstring& other) : bits_(other.is_heap() ? make_word(other.heap_chars(), other.size()) : other.bits_) {}
+
+        // @brief move constructor, steals the word
+        basic_thin_sstring(basic_thin_sstring&& other) noexcept : bits_(std::exchange(other.bits_, 0)) {}
+
+        // @brief destructor
+        ~basic_thin_sstring() {
+            release();
+        }
+
+        // @brief copy assignment
+        basic_thin_sstring& operator=(const basic_thin_sstring& other) {
+            if (this != &other) {
+                assign(other.view());
+            }
+            return *this;
+        }
+
+        // @brief move assignment
+        basic_thin_sstring& operator=(basic_thin_sstring&& other) noexcept {
+            if (this != &other) {
+                release();
+                bits_ = std::exchange(other.bits_, 0);
+            }
+            return *this;
+        }
+
+        // @brief assign from a view
+        basic_thin_sstring& operator=(view_type sv) {
+            return assign(sv);
+        }
+        basic_thin_sstring& operator=(const CharT* s) {
+            return assign(view_type(s));
+        }
+
+        // @brief replace the contents, sv may alias this string
+        basic_thin_sstring& assign(view_type sv) {
+            // reuse the heap block for long contents that still fit
+            if (is_heap() && sv.size() > inline_capacity && sv.size() <= heap_header()->cap) {
+                std::memmove(heap_chars(), sv.data(), sv.size());
+                heap_chars()[sv.size()] = CharT();
+                heap_header()->size = sv.size();
+                return *this;
+            }
+            const std::uintptr_t w = make_word(sv.data(), sv.size());
+            release();
+            bits_ = w;
+            return *this;
+        }
+
+    public:
+        // @brief size, O(1) for both forms
+        size_type size() const noexcept {
+            if (is_inline()) {
+                return inline_size();
+            }
+            return bits_ ? heap_header()->size : 0;
+        }
+        size_type length() const noexcept {
+            return size();
+        }
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        // @brief capacity before the next allocation
+        size_type capacity() const noexcept {
+            return is_heap() ? heap_header()->cap : inline_capacity;
+        }
+
+        // @brief chars, inline chars live inside this object and are not null terminated
+        const CharT* data() const noexcept {
+            if (is_inline()) {
+                return inline_chars();
+            }
+            return bits_ ? heap_chars() : reinterpret_cast<const CharT*>(&bits_);
+        }
+
+        // @brief view of the chars, invalidated by moves of an inline string
+        view_type view() const noexcept {
+            return view_type(data(), size());
+        }
+        operator view_type() const noexcept {
+            return view();
+        }
+
+        // @brief element access
+        CharT operator[](size_type i) const noexcept {
+            return data()[i];
+        }
+        CharT front() const noexcept {
+            return data()[0];
+        }
+        CharT back() const noexcept {
+            return data()[size() - 1];
+        }
+
+        // @brief raw word, 0 for empty strings
+        constexpr std::uintptr_t raw() const noexcept {
+            return bits_;
+        }
+
+    public:
+        // @brief reserve room for at least n chars
+        void reserve(size_type n) {
+            if (n <= capacity()) {
+                return;
+            }
+            const size_type sz = size();
+            CharT* p = allocate_block(n);
+            std::memcpy(p, data(), sz);
+            p[sz] = CharT();
+            reinterpret_cast<header*>(p)[-1].size = sz;
+            release();
+            bits_ = reinterpret_cast<std::uintptr_t>(p);
+        }
+
+        // @brief append chars, sv may alias this string
+        basic_thin_sstring& append(const CharT* s, size_type n) {
+            if (n == 0) {
+                return *this;
+            }
+            const size_type sz = size();
+            const size_type total = sz + n;
+            if (total <= inline_capacity && !is_heap()) {
+                CharT buf[inline_capacity];
+                std::memcpy(buf, data(), sz);
+                std::memcpy(buf + sz, s, n);
+                bits_ = make_inline(buf, total);
+                return *this;
+            }
+            if (is_heap() && total <= heap_header()->cap) {
+                std::memmove(heap_chars() + sz, s, n);
+                heap_chars()[total] = CharT();
+                heap_header()->size = total;
+                return *this;
+            }
+            // grow geometrically, the source stays readable until the old block is released
+            CharT* p = allocate_block(std::max(total, capacity() * 2));
+            std::memcpy(p, data(), sz);
+            std::memcpy(p + sz, s, n);
+            p[total] = CharT();
+            reinterpret_cast<header*>(p)[-1].size = total;
+            release();
+            bits_ = reinterpret_cast<std::uintptr_t>(p);
+            return *this;
+        }
+        basic_thin_sstring& append(view_type sv) {
+            return append(sv.data(), sv.size());
+        }
+        basic_thin_sstring& operator+=(view_type sv) {
+            return append(sv.data(), sv.size());
+        }
+        basic_thin_sstring& operator+=(CharT ch) {
+            return append(&ch, 1);
+        }
+        void push_back(CharT ch) {
+            append(&ch, 1);
+        }
+
+        // @brief become empty and release the heap block
+        void clear() noexcept {
+            release();
+        }
+
+        // @brief swap the words
+        void swap(basic_thin_sstring& other) noexcept {
+            std::swap(bits_, other.bits_);
+        }
+
+    public:
+        // @brief find a char, same simd kernel as basic_sstring
+        size_type find(CharT ch, size_type pos = 0) const noexcept {
+            const size_type n = size();
+            if (pos >= n) {
+                return npos;
+            }
+            const CharT* base = data();
+            const void* p = simd::memchr(base + pos, static_cast<unsigned char>(ch), n - pos);
+            return p ? static_cast<size_type>(static_cast<const CharT*>(p) - base) : npos;
+        }
+
+        // @brief find a substring, same kernel dispatch as basic_sstring::find
+        size_type find(view_type sv, size_type pos = 0) const noexcept {
+            const size_type n = size();
+            const size_type m = sv.size();
+            if (m == 0) {
+                return pos <= n ? pos : npos;
+            }
+            if (pos >= n || m > n - pos) {
+                return npos;
+            }
+            const CharT* base = data();
+            const void* p = find_bytes(base + pos, n - pos, sv.data(), m);
+            return p ? static_cast<size_type>(static_cast<const CharT*>(p) - base) : npos;
+        }
+
+        // @brief containment and affix tests
+        bool contains(CharT ch) const noexcept {
+            return find(ch) != npos;
+        }
+        bool contains(view_type sv) const noexcept {
+            return find(sv) != npos;
+        }
+        bool starts_with(view_type sv) const noexcept {
+            return sv.size() <= size() && simd::memcmp(data(), sv.data(), sv.size()) == 0;
+        }
+        bool ends_with(view_type sv) const noexcept {
+            const size_type n = size();
+            return sv.size() <= n && simd::memcmp(data() + n - sv.size(), sv.data(), sv.size()) == 0;
+        }
+
+        // @brief compare with another string
+        int compare(view_type sv) const noexcept {
+            const size_type lhs_sz = size();
+            const size_type rhs_sz = sv.size();
+            const int r = simd::memcmp(data(), sv.data(), std::min(lhs_sz, rhs_sz));
+            if (r != 0) {
+                return r < 0 ? -1 : 1;
+            }
+            return lhs_sz < rhs_sz ? -1 : (lhs_sz > rhs_sz ? 1 : 0);
+        }
+
+        // @brief content hash, equal to basic_sstring::hash() for the same chars
+        size_type hash() const noexcept {
+            return hash_string(data(), size());
+        }
+
+        // @brief convert to a basic_sstring, or any string constructible from a view
+        template<typename S = basic_sstring<CharT, Traits, Allocator>>
+        S to_sstring() const {
+            return S(view());
+        }
+
+    public:
+        // @brief equality, equal words are equal strings without touching the heap
+        friend bool operator==(const basic_thin_sstring& a, const basic_thin_sstring& b) noexcept {
+            if (a.bits_ == b.bits_) {
+                return true;
+            }
+            return a.size() == b.size() && simd::memcmp(a.data(), b.data(), a.size()) == 0;
+        }
+        friend bool operator==(const basic_thin_sstring& a, view_type b) noexcept {
+            return a.size() == b.size() && simd::memcmp(a.data(), b.data(), b.size()) == 0;
+        }
+        friend bool operator==(const basic_thin_sstring& a, const CharT* b) noexcept {
+            return a == view_type(b);
+        }
+
+        // @brief ordering (in content)
+        friend auto operator<=>(const basic_thin_sstring& a, const basic_thin_sstring& b) noexcept {
+            return a.compare(b.view()) <=> 0;
+        }
+        friend auto operator<=>(const basic_thin_sstring& a, view_type b) noexcept {
+            return a.compare(b) <=> 0;
+        }
+        friend auto operator<=>(const basic_thin_sstring& a, const CharT* b) noexcept {
+            return a.compare(view_type(b)) <=> 0;
+        }
+    };
+
+    // convenience alias for char thin sstring
+    using thin_sstring = basic_thin_sstring<char>;
+
+}
+// namespace libsstring ends
+
+// namespace std starts
+namespace std {
+
+    // hash specialization for thin strings, reuses the content hash
+    template<class CharT, class Traits, class Allocator>
+    struct hash<libsstring::basic_thin_sstring<CharT, Traits, Allocator>> {
+        size_t operator()(const libsstring::basic_thin_sstring<CharT, Traits, Allocator>& s) const noexcept {
+            return s.hash();
+        }
+    };
+
+}
+// namespace std ends
@@ -0,0 +1,570 @@
+// sstring_vector.hpp
+// 
+// Project sstring Version 0.0.1 built 251121
+// CopyRight: 2025 Nathmath/DOF Studio
+// Requires: C++20 Compiler and STL
+// Website: https://github.com/dof-studio/sstring
+// License: MIT License
+// Copyright (c) 2016-2025 Nathmath/DOF Studio
+// 
+// Permission is hereby granted, free of charge, to any person 
+// obtaining a copy of this software and associated documentation 
+// files (the "Software"), to deal in the Software without 
+// restriction, including without limitation the rights to use, copy, 
+// modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is 
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be 
+// ncluded in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, 
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND 
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS 
+// BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN 
+// ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE 
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <initializer_list>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "sstring.hpp"
+
+// namespace libsstring starts
+namespace libsstring {
+
+    // Columnar string array, every string's chars sit back to back in one blob and an array of
+    // end offsets marks the boundaries, element access yields string views into the blob
+    template<
+        typename CharT = char,
+        typename Traits = std::char_traits<CharT>,
+        typename Allocator = std::allocator<CharT>
+    >
+    class basic_sstring_vector {
+        static_assert(sizeof(CharT) == 1, "basic_sstring_vector currently supports only byte-sized CharT, aka. char");
+    // Public types
+    public:
+        using value_type = std::basic_string_view<CharT, Traits>;
+        using reference = value_type;
+        using const_reference = value_type;
+        using traits_type = Traits;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using string_view_type = std::basic_string_view<CharT, Traits>;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // first blob allocation, later ones double
+        static constexpr size_type min_blob = 64;
+
+    private:
+        using char_alloc_traits = std::allocator_traits<Allocator>;
+        using offset_alloc_type = typename char_alloc_traits::template rebind_alloc<size_type>;
+
+        Allocator alloc_;
+        CharT* blob_ = nullptr;                  // chars of every string, no terminators
+        size_type blob_size_ = 0;
+        size_type blob_cap_ = 0;
+        std::vector<size_type, offset_alloc_type> ends_; // ends_[i] is one past the last char of string i
+
+    public:
+        // Random access iterator yielding string views
+        class const_iterator {
+            const basic_sstring_vector* owner_ = nullptr;
+            size_type i_ = 0;
+
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::input_iterator_tag;
+            using value_type = string_view_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = string_view_type;
+
+            const_iterator() = default;
+            const_iterator(const basic_sstring_vector* owner, size_type i) noexcept : owner_(owner), i_(i) {}
+
+            string_view_type operator*() const noexcept {
+                return (*owner_)[i_];
+            }
+            string_view_type operator[](difference_type k) const noexcept {
+                return (*owner_)[static_cast<size_type>(static_cast<difference_type>(i_) + k)];
+            }
+
+            // @brief index of the element
+            size_type index() const noexcept {
+                return i_;
+            }
+
+            const_iterator& operator++() noexcept {
+                ++i_;
+                return *this;
+            }
+            const_iterator operator++(int) noexcept {
+                const_iterator t = *this;
+                ++i_;
+                return t;
+            }
+            const_iterator& operator--() noexcept {
+                --i_;
+                return *this;
+            }
+            const_iterator operator--(int) noexcept {
+                const_iterator t = *this;
+                --i_;
+                return t;
+            }
+            const_iterator& operator+=(difference_type k) noexcept {
+                i_ = static_cast<size_type>(static_cast<difference_type>(i_) + k);
+                return *this;
+            }
+            const_iterator& operator-=(difference_type k) noexcept {
+                i_ = static_cast<size_type>(static_cast<difference_type>(i_) - k);
+                return *this;
+            }
+            friend const_iterator operator+(const_iterator it, difference_type k) noexcept {
+                return it += k;
+            }
+            friend const_iterator operator+(difference_type k, const_iterator it) noexcept {
+                return it += k;
+            }
+            friend const_iterator operator-(const_iterator it, difference_type k) noexcept {
+                return it -= k;
+            }
+            friend difference_type operator-(const const_iterator& a, const const_iterator& b) noexcept {
+                return static_cast<difference_type>(a.i_) - static_cast<difference_type>(b.i_);
+            }
+            friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept {
+                return a.i_ == b.i_;
+            }
+            friend auto operator<=>(const const_iterator& a, const const_iterator& b) noexcept {
+                return a.i_ <=> b.i_;
+            }
+        };
+        using iterator = const_iterator;
+
+    private:
+        // @brief first char of string i
+        size_type start_of(size_type i) const noexcept {
+            return i ? ends_[i - 1] : 0;
+        }
+
+        // @brief move the blob into an allocation of exactly cap chars
+        void reallocate_blob(size_type cap) {
+            CharT* p = char_alloc_traits::allocate(alloc_, cap);
+            if (blob_size_) {
+                std::memcpy(p, blob_, blob_size_);
+            }
+            if (blob_) {
+                char_alloc_traits::deallocate(alloc_, blob_, blob_cap_);
+            }
+            blob_ = p;
+            blob_cap_ = cap;
+        }
+
+        // @brief room for extra more chars, doubling
+        void grow_blob(size_type extra) {
+            const size_type need = blob_size_ + extra;
+            if (need > blob_cap_) {
+                reallocate_blob(std::max({ need, blob_cap_ * 2, min_blob }));
+            }
+        }
+
+        // @brief release the blob
+        void free_blob() noexcept {
+            if (blob_) {
+                char_alloc_traits::deallocate(alloc_, blob_, blob_cap_);
+            }
+            blob_ = nullptr;
+            blob_size_ = blob_cap_ = 0;
+        }
+
+        // @brief steal the storage of another vector
+        void take(basic_sstring_vector& other) noexcept {
+            blob_ = std::exchange(other.blob_, nullptr);
+            blob_size_ = std::exchange(other.blob_size_, 0);
+            blob_cap_ = std::exchange(other.blob_cap_, 0);
+            ends_ = std::move(other.ends_);
+            other.ends_.clear();
+        }
+
+        // @brief big-endian first 8 chars, zero padded, orders like memcmp on the prefix
+        static std::uint64_t prefix_key(string_view_type s) noexcept {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(s.data());
+            const size_type k = std::min<size_type>(s.size(), 8);
+            std::uint64_t key = 0;
+            for (size_type j = 0; j < k; ++j) {
+                key |= std::uint64_t(p[j]) << (56 - 8 * j);
+            }
+            return key;
+        }
+
+        // @brief equality with the length checked first
+        static bool equal_views(string_view_type a, string_view_type b) noexcept {
+            return a.size() == b.size() && simd::memcmp(a.data(), b.data(), a.size()) == 0;
+        }
+
+    public:
+        // @brief default constructor
+        basic_sstring_vector() : basic_sstring_vector(Allocator()) {}
+        explicit basic_sstring_vector(const Allocator& alloc) : alloc_(alloc), ends_(offset_alloc_type(alloc)) {}
+
+        // @brief construct from a list of strings
+        basic_sstring_vector(std::initializer_list<string_view_type> list, const Allocator& alloc = Allocator()) : basic_sstring_vector(alloc) {
+            append_range(list);
+        }
+
+        // @brief construct from any range of strings, e.g. std::vector<basic_sstring>
+        template <std::ranges::input_range R>
+            requires (std::is_convertible_v<std::ranges::range_reference_t<R>, string_view_type> &&
+                      !std::is_same_v<std::remove_cvref_t<R>, basic_sstring_vector>)
+        explicit basic_sstring_vector(R&& r, const Allocator& alloc = Allocator()) : basic_sstring_vector(alloc) {
+            append_range(std::forward<R>(r));
+        }
+
+        // @brief copy constructor, the blob is copied in one piece
+        basic_sstring_vector(const basic_sstring_vector& other)
+            : basic_sstring_vector(char_alloc_traits::select_on_container_copy_construction(other.alloc_)) {
+            append(other);
+        }
+
+        // @brief move constructor
+        basic_sstring_vector(basic_sstring_vector&& other) noexcept : alloc_(other.alloc_), ends_(offset_alloc_type(other.alloc_)) {
+            take(other);
+        }
+
+        // @brief destructor
+        ~basic_sstring_vector() {
+            free_blob();
+        }
+
+        // @brief copy assignment, keeps this allocator
+        basic_sstring_vector& operator=(const basic_sstring_vector& other) {
+            if (this != &other) {
+                clear();
+                append(other);
+            }
+            return *this;
+        }
+
+        // @brief move assignment, copies when the allocators cannot exchange memory
+        basic_sstring_vector& operator=(basic_sstring_vector&& other) noexcept(char_alloc_traits::is_always_equal::value) {
+            if (this == &other) {
+                return *this;
+            }
+            if (char_alloc_traits::is_always_equal::value || alloc_ == other.alloc_) {
+                free_blob();
+                take(other);
+            }
+            else {
+                clear();
+                append(other);
+            }
+            return *this;
+        }
+
+    public:
+        // @brief element count
+        size_type size() const noexcept {
+            return ends_.size();
+        }
+        bool empty() const noexcept {
+            return ends_.empty();
+        }
+
+        // @brief chars over all elements
+        size_type blob_size() const noexcept {
+            return blob_size_;
+        }
+        size_type blob_capacity() const noexcept {
+            return blob_cap_;
+        }
+        size_type capacity() const noexcept {
+            return ends_.capacity();
+        }
+
+        // @brief the blob and the end offsets, for bulk consumers
+        string_view_type blob() const noexcept {
+            return string_view_type(blob_, blob_size_);
+        }
+        std::span<const size_type> ends() const noexcept {
+            return std::span<const size_type>(ends_.data(), ends_.size());
+        }
+
+        // @brief element access
+        string_view_type operator[](size_type i) const noexcept {
+            const size_type b = start_of(i);
+            return string_view_type(blob_ + b, ends_[i] - b);
+        }
+        string_view_type at(size_type i) const {
+            if (i >= size()) {
+                throw std::out_of_range("basic_sstring_vector::at");
+            }
+            return (*this)[i];
+        }
+        string_view_type front() const noexcept {
+            return (*this)[0];
+        }
+        string_view_type back() const noexcept {
+            return (*this)[size() - 1];
+        }
+
+        // @brief length of element i without touching the blob
+        size_type length_of(size_type i) const noexcept {
+            return ends_[i] - start_of(i);
+        }
+
+        // @brief iteration
+        const_iterator begin() const noexcept {
+            return const_iterator(this, 0);
+        }
+        const_iterator end() const noexcept {
+            return const_iterator(this, size());
+        }
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+        // @brief allocator access
+        allocator_type get_allocator() const noexcept {
+            return alloc_;
+        }
+
+    public:
+        // @brief reserve room for n elements and chars chars in total
+        void reserve(size_type n, size_type chars = 0) {
+            ends_.reserve(n);
+            if (chars > blob_cap_) {
+                reallocate_blob(chars);
+            }
+        }
+
+        // @brief drop unused capacity
+        void shrink_to_fit() {
+            ends_.shrink_to_fit();
+            if (blob_size_ == 0) {
+                free_blob();
+            }
+            else if (blob_size_ < blob_cap_) {
+                reallocate_blob(blob_size_);
+            }
+        }
+
+        // @brief remove every element, capacity is kept
+        void clear() noexcept {
+            ends_.clear();
+            blob_size_ = 0;
+        }
+
+        // @brief append a string, sv may point into this vector
+        void push_back(string_view_type sv) {
+            const size_type n = sv.size();
+            const CharT* src = sv.data();
+            if (blob_size_ + n > blob_cap_) {
+                const bool inside = blob_ && src >= blob_ && src < blob_ + blob_size_;
+                const size_type off = inside ? static_cast<size_type>(src - blob_) : 0;
+                grow_blob(n);
+                if (inside) {
+                    src = blob_ + off;
+                }
+            }
+            ends_.push_back(blob_size_ + n);
+            if (n) {
+                std::memcpy(blob_ + blob_size_, src, n);
+            }
+            blob_size_ += n;
+        }
+        template <typename S>
+            requires (std::is_convertible_v<const S&, string_view_type> && !std::is_convertible_v<const S&, const CharT*>)
+        void push_back(const S& s) {
+            push_back(string_view_type(s));
+        }
+        void push_back(const CharT* s) {
+            push_back(string_view_type(s));
+        }
+
+        // @brief remove the last element
+        void pop_back() noexcept {
+            ends_.pop_back();
+            blob_size_ = ends_.empty() ? 0 : ends_.back();
+        }
+
+        // @brief append a range of strings, forward ranges size the blob and the offsets once up front
+        template <std::ranges::input_range R>
+            requires std::is_convertible_v<std::ranges::range_reference_t<R>, string_view_type>
+        void append_range(R&& r) {
+            if constexpr (std::ranges::sized_range<R>) {
+                ends_.reserve(ends_.size() + static_cast<size_type>(std::ranges::size(r)));
+            }
+            if constexpr (std::ranges::forward_range<R>) {
+                size_type chars = 0;
+                for (auto&& s : r) {
+                    chars += string_view_type(s).size();
+                }
+                grow_blob(chars);
+            }
+            for (auto&& s : r) {
+                push_back(string_view_type(s));
+            }
+        }
+
+        // @brief append another vector, one blob copy plus shifted offsets
+        void append(const basic_sstring_vector& other) {
+            const size_type n = other.size();
+            const size_type chars = other.blob_size_;
+            ends_.reserve(ends_.size() + n);
+            grow_blob(chars);
+            if (chars) {
+                std::memcpy(blob_ + blob_size_, other.blob_, chars);
+            }
+            const size_type base = blob_size_;
+            for (size_type i = 0; i < n; ++i) {
+                ends_.push_back(base + other.ends_[i]);
+            }
+            blob_size_ += chars;
+        }
+
+        // @brief swap contents and allocators
+        void swap(basic_sstring_vector& other) noexcept {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+            swap(blob_, other.blob_);
+            swap(blob_size_, other.blob_size_);
+            swap(blob_cap_, other.blob_cap_);
+            ends_.swap(other.ends_);
+        }
+
+    public:
+        // @brief index of the first element from pos equal to sv, npos if none;
+        //        the whole blob is scanned with the simd substring kernel and hits are mapped back to elements
+        size_type find(string_view_type sv, size_type pos = 0) const noexcept {
+            const size_type n = size();
+            const size_type m = sv.size();
+            if (m == 0) {
+                for (size_type i = pos; i < n; ++i) {
+                    if (ends_[i] == start_of(i)) {
+                        return i;
+                    }
+                }
+                return npos;
+            }
+            size_type from = pos < n ? start_of(pos) : blob_size_;
+            while (from + m <= blob_size_) {
+                const void* hit = find_bytes(blob_ + from, blob_size_ - from, sv.data(), m);
+                if (!hit) {
+                    return npos;
+                }
+                const size_type at = static_cast<size_type>(static_cast<const CharT*>(hit) - blob_);
+                // the element holding the hit, empty elements before it end at or before at
+                const size_type i = static_cast<size_type>(std::upper_bound(ends_.begin() + pos, ends_.end(), at) - ends_.begin());
+                if (start_of(i) == at && ends_[i] == at + m) {
+                    return i;
+                }
+                // a match has to start an element, so skip to the next one
+                from = ends_[i];
+                pos = i + 1;
+            }
+            return npos;
+        }
+        bool contains(string_view_type sv) const noexcept {
+            return find(sv) != npos;
+        }
+
+        // @brief sort ascending, elements are ordered by an 8-char prefix key first and
+        //        compared in full only on prefix ties, then the blob is rebuilt in order
+        void sort() {
+            const size_type n = size();
+            if (n < 2) {
+                return;
+            }
+            constexpr bool byte_order = std::is_same_v<Traits, std::char_traits<CharT>>;
+            std::vector<std::pair<std::uint64_t, size_type>> keys(n);
+            for (size_type i = 0; i < n; ++i) {
+                keys[i] = { byte_order ? prefix_key((*this)[i]) : 0, i };
+            }
+            std::sort(keys.begin(), keys.end(), [this](const auto& a, const auto& b) noexcept {
+                if (a.first != b.first) {
+                    return a.first < b.first;
+                }
+                return (*this)[a.second].compare((*this)[b.second]) < 0;
+            });
+            // gather into a fresh blob in sorted order
+            basic_sstring_vector out(alloc_);
+            out.reserve(n, blob_size_);
+            for (const auto& k : keys) {
+                out.push_back((*this)[k.second]);
+            }
+            free_blob();
+            take(out);
+        }
+
+        // @brief remove consecutive duplicates in place, lengths are compared before chars, returns the new size
+        size_type unique() noexcept {
+            const size_type n = size();
+            if (n < 2) {
+                return n;
+            }
+            size_type w = 1;                     // elements kept
+            size_type read_start = ends_[0];     // original start of element r
+            for (size_type r = 1; r < n; ++r) {
+                const size_type rs = read_start;
+                const size_type re = ends_[r];
+                read_start = re;
+                const string_view_type cur(blob_ + rs, re - rs);
+                if (equal_views(cur, (*this)[w - 1])) {
+                    continue;
+                }
+                const size_type wpos = ends_[w - 1];
+                if (wpos != rs) {
+                    std::memmove(blob_ + wpos, blob_ + rs, re - rs);
+                }
+                ends_[w++] = wpos + (re - rs);
+            }
+            ends_.resize(w);
+            blob_size_ = ends_.back();
+            return w;
+        }
+
+        // @brief copy out to a vector of strings, sized once
+        template <typename String = basic_sstring<CharT, Traits, Allocator>>
+        std::vector<String> to_vector() const {
+            std::vector<String> out;
+            out.reserve(size());
+            for (size_type i = 0; i < size(); ++i) {
+                out.emplace_back((*this)[i]);
+            }
+            return out;
+        }
+
+    public:
+        // @brief element-wise equality, the offsets and the blob are compared in bulk
+        friend bool operator==(const basic_sstring_vector& a, const basic_sstring_vector& b) noexcept {
+            return a.ends_.size() == b.ends_.size() && a.blob_size_ == b.blob_size_
+                && std::equal(a.ends_.begin(), a.ends_.end(), b.ends_.begin())
+                && simd::memcmp(a.blob_, b.blob_, a.blob_size_) == 0;
+        }
+    };
+
+    // convenience alias for char sstring vector
+    using sstring_vector = basic_sstring_vector<char>;
+
+}
+// namespace libsstring ends